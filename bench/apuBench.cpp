@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "apu.h"
+
+// Times the APU with all four channels playing, noise at its fastest clock, fed one instruction's
+// worth of cycles at a time as the core does. Fails when generating the sound of one emulated
+// second costs more than the budget share of a second of wall time.
+namespace
+{
+    constexpr double BUDGET_PERCENT = 5.0;
+
+    // Best of a few rounds, in percent of real time
+    double measure(gasyboy::Apu &apu, const int &seconds)
+    {
+        const uint64_t cycles = static_cast<uint64_t>(gasyboy::Apu::CLOCK_RATE) * seconds;
+        double best = 0;
+        for (int round = 0; round < 5; round++)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (uint64_t cycle = 0; cycle < cycles; cycle += 8)
+            {
+                apu.update(8);
+            }
+            apu.endFrame();
+            const double percent = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / seconds * 100;
+            best = round ? std::min(best, percent) : percent;
+        }
+        return best;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const int seconds = argc > 1 ? std::max(1, std::stoi(argv[1])) : 10;
+
+    gasyboy::Utilities utilities;
+    utilities.executeBios = true;
+    gasyboy::Apu apu(utilities);
+
+    size_t frames = 0;
+    apu.setSampleHandler([&frames](const int16_t *, const size_t &count)
+                         { frames += count; });
+
+    const std::pair<uint16_t, uint8_t> writes[] = {
+        {0xFF26, 0x80}, {0xFF24, 0x77}, {0xFF25, 0xFF},
+        // Square 1 at 1 kHz sweeping down, square 2 at 2 kHz
+        {0xFF10, 0x7F}, {0xFF11, 0x80}, {0xFF12, 0xF0}, {0xFF13, 0x83}, {0xFF14, 0x87},
+        {0xFF16, 0x40}, {0xFF17, 0xF0}, {0xFF18, 0xC1}, {0xFF19, 0x87},
+        // Wave at 440 Hz
+        {0xFF30, 0x01}, {0xFF31, 0x23}, {0xFF32, 0x45}, {0xFF33, 0x67}, {0xFF34, 0x89}, {0xFF35, 0xAB},
+        {0xFF36, 0xCD}, {0xFF37, 0xEF}, {0xFF1A, 0x80}, {0xFF1C, 0x20}, {0xFF1D, 0x6B}, {0xFF1E, 0x87},
+        // Noise clocked every 8 cycles
+        {0xFF21, 0xF0}, {0xFF22, 0x00}, {0xFF23, 0x80}};
+    for (const auto &[address, value] : writes)
+    {
+        apu.write(address, value);
+    }
+
+    const double playing = measure(apu, seconds);
+    const size_t playedFrames = frames;
+
+    // Nothing listening, the channels are only counted
+    apu.setSampleHandler(nullptr);
+    const double silent = measure(apu, seconds);
+
+    std::cout << "channels enabled (NR52): " << std::hex << static_cast<int>(apu.read(0xFF26)) << std::dec << "\n"
+              << "sample frames: " << playedFrames << "\n"
+              << "percent of a core at 1x: " << playing << "\n"
+              << "percent of a core without a sample handler: " << silent << "\n";
+
+    return playing > BUDGET_PERCENT ? 1 : 0;
+}
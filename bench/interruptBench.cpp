@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "nullFrontend.h"
+#include "gbException.h"
+#include "gameboy.h"
+
+// Times the interrupt check run before every instruction, against the IF & IE read through the MMU
+// it replaces, and the frame rate of a game with it.
+// Fails when the check with nothing pending costs more than the budget per call.
+namespace
+{
+    constexpr double BUDGET_NS = 2.0;
+
+    // Best of a few rounds, in nanoseconds per call
+    template <typename F>
+    double measure(const int &calls, F &&run)
+    {
+        double best = 0;
+        for (int round = 0; round < 5; round++)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (int call = 0; call < calls; call++)
+            {
+                run();
+            }
+            const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / calls;
+            best = round ? std::min(best, ns) : ns;
+        }
+        return best;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "usage: interruptBench rom_file_path [calls]\n";
+        return 1;
+    }
+
+    const int calls = argc > 2 ? std::max(1, std::stoi(argv[2])) : 10000000;
+
+    auto utilities = std::make_shared<gasyboy::Utilities>();
+    utilities->romFilePath = argv[1];
+    utilities->executeBios = false;
+    utilities->threadedEmulation = false;
+    utilities->speed = gasyboy::GameBoy::SPEED_UNCAPPED;
+
+    try
+    {
+        auto gameboy = std::make_unique<gasyboy::GameBoy>(utilities,
+                                                          std::make_unique<gasyboy::NullRenderer>(),
+                                                          std::make_unique<gasyboy::NullInputHandler>());
+        auto &interruptManager = gameboy->getInterruptManager();
+        auto &mmu = gameboy->getMmu();
+
+        // The game first, before its interrupt registers are poked below
+        const int frames = 600;
+        const auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; frame++)
+        {
+            gameboy->loop();
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // Enabled but nothing requested, the common case between instructions
+        interruptManager.setMasterInterrupt(true);
+        interruptManager.setIE(0x1F);
+        interruptManager.setIF(0);
+
+        volatile uint8_t sink = 0;
+        const double check = measure(calls, [&]()
+                                     { interruptManager.handleInterrupts(); });
+        const double mmuCheck = measure(calls, [&]()
+                                        { sink = sink + (mmu.readRam(0xFF0F) & mmu.readRam(0xFFFF) & 0x1F); });
+        const double request = measure(calls, [&]()
+                                       {
+            interruptManager.requestInterrupt(gasyboy::InterruptManager::InterruptType::Timer);
+            interruptManager.setIF(0); });
+
+        std::cout << "pending check ns: " << check << "\n"
+                  << "IF & IE through the MMU ns: " << mmuCheck << "\n"
+                  << "request and clear ns: " << request << "\n"
+                  << "frames per second: " << frames / seconds << "\n";
+
+        if (check > BUDGET_NS)
+        {
+            return 1;
+        }
+    }
+    catch (const gasyboy::exception::GbException &e)
+    {
+        std::cout << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
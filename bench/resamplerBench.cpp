@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "apu.h"
+#include "blipBuffer.h"
+
+// Times the band-limited resampler alone at each quality preset: frames of 4 MHz clocks with a fixed
+// number of stereo level changes, resampled to 48 kHz and read back once per frame as the APU does.
+// Reports output samples per second, and fails when the high preset takes more than the budget
+// share of a core at 1x.
+namespace
+{
+    constexpr double BUDGET_PERCENT = 5.0;
+    constexpr uint32_t FRAME_CLOCKS = 70224;
+    constexpr int SAMPLE_RATE = 48000;
+
+    struct Delta
+    {
+        uint32_t time;
+        int32_t left;
+        int32_t right;
+    };
+
+    // Sorted times and deltas within what the APU produces, the same for every preset
+    std::vector<Delta> makeDeltas(const int &count)
+    {
+        std::vector<Delta> deltas(count);
+        uint32_t seed = 0x2545F491;
+        auto next = [&seed]()
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            return seed;
+        };
+
+        for (auto &delta : deltas)
+        {
+            delta.time = next() % FRAME_CLOCKS;
+            delta.left = static_cast<int32_t>(next() % 11521) - 5760;
+            delta.right = static_cast<int32_t>(next() % 11521) - 5760;
+        }
+        std::sort(deltas.begin(), deltas.end(), [](const Delta &a, const Delta &b)
+                  { return a.time < b.time; });
+        return deltas;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    // About what all four channels give with the noise clocked every 8 cycles
+    const int deltasPerFrame = argc > 1 ? std::max(1, std::stoi(argv[1])) : 4000;
+    const int frames = argc > 2 ? std::max(1, std::stoi(argv[2])) : 600;
+
+    const auto deltas = makeDeltas(deltasPerFrame);
+    std::vector<int16_t> samples(8192 * 2);
+
+    std::cout << "instruction set: " << gasyboy::BlipBuffer::instructionSet() << "\n"
+              << "level changes per frame: " << deltasPerFrame << "\n";
+
+    const std::pair<const char *, gasyboy::BlipBuffer::Quality> presets[] = {
+        {"low", gasyboy::BlipBuffer::Quality::LOW},
+        {"medium", gasyboy::BlipBuffer::Quality::MEDIUM},
+        {"high", gasyboy::BlipBuffer::Quality::HIGH}};
+
+    double highPercent = 0;
+    for (const auto &[name, quality] : presets)
+    {
+        gasyboy::BlipBuffer buffer(8192, quality);
+        buffer.setRates(gasyboy::Apu::CLOCK_RATE, SAMPLE_RATE);
+
+        // Best of a few rounds
+        double best = 0;
+        size_t produced = 0;
+        for (int round = 0; round < 5; round++)
+        {
+            produced = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < frames; frame++)
+            {
+                for (const auto &delta : deltas)
+                {
+                    buffer.addDelta(delta.time, delta.left, delta.right);
+                }
+                buffer.endFrame(FRAME_CLOCKS);
+                produced += buffer.readSamples(samples.data(), buffer.samplesAvailable());
+            }
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            best = round ? std::min(best, seconds) : seconds;
+        }
+
+        const double emulated = static_cast<double>(frames) * FRAME_CLOCKS / gasyboy::Apu::CLOCK_RATE;
+        const double percent = best / emulated * 100;
+        if (quality == gasyboy::BlipBuffer::Quality::HIGH)
+        {
+            highPercent = percent;
+        }
+
+        std::cout << name << ": " << static_cast<uint64_t>(produced / best) << " stereo samples/s, "
+                  << static_cast<uint64_t>(static_cast<double>(deltasPerFrame) * frames / best) << " level changes/s, "
+                  << percent << "% of a core at 1x\n";
+    }
+
+    return highPercent > BUDGET_PERCENT ? 1 : 0;
+}
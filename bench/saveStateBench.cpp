@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "nullFrontend.h"
+#include "gbException.h"
+#include "gameboy.h"
+#include "utils.h"
+
+// Times save state capture and restore on a running game.
+// Fails when either one averages above the budget, or when a restored state does not replay the same frames.
+namespace
+{
+    constexpr double BUDGET_US = 100.0;
+
+    struct Timing
+    {
+        double mean = 0;
+        double min = 0;
+        double max = 0;
+    };
+
+    template <typename F>
+    Timing measure(const int &iterations, F &&run)
+    {
+        std::vector<double> samples(iterations);
+        for (auto &sample : samples)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            run();
+            sample = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        Timing timing;
+        for (const auto &sample : samples)
+            timing.mean += sample;
+        timing.mean /= iterations;
+        timing.min = *std::min_element(samples.begin(), samples.end());
+        timing.max = *std::max_element(samples.begin(), samples.end());
+        return timing;
+    }
+
+    uint64_t runFrames(gasyboy::GameBoy &gameboy, const int &frames)
+    {
+        for (int frame = 0; frame < frames; frame++)
+        {
+            gameboy.loop();
+        }
+        auto &ppu = gameboy.getPpu();
+        return gasyboy::utils::hash64(ppu._framebuffer, sizeof(ppu._framebuffer));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "usage: saveStateBench rom_file_path [iterations]\n";
+        return 1;
+    }
+
+    const int iterations = argc > 2 ? std::max(1, std::stoi(argv[2])) : 10000;
+
+    auto utilities = std::make_shared<gasyboy::Utilities>();
+    utilities->romFilePath = argv[1];
+    utilities->executeBios = false;
+    utilities->threadedEmulation = false;
+    utilities->speed = gasyboy::GameBoy::SPEED_UNCAPPED;
+
+    try
+    {
+        auto gameboy = std::make_unique<gasyboy::GameBoy>(utilities,
+                                                          std::make_unique<gasyboy::NullRenderer>(),
+                                                          std::make_unique<gasyboy::NullInputHandler>());
+        runFrames(*gameboy, 300);
+
+        std::vector<uint8_t> buffer(gameboy->saveStateSize());
+        const auto save = measure(iterations, [&]()
+                                  { gameboy->saveState(buffer.data(), buffer.size()); });
+        const auto load = measure(iterations, [&]()
+                                  { gameboy->loadState(buffer.data(), buffer.size()); });
+
+        // Restoring must replay exactly the frames run after the capture
+        const uint64_t expected = runFrames(*gameboy, 120);
+        gameboy->loadState(buffer.data(), buffer.size());
+        const uint64_t replayed = runFrames(*gameboy, 120);
+
+        std::cout << "state size: " << buffer.size() << " bytes\n"
+                  << "save us: mean " << save.mean << " min " << save.min << " max " << save.max << "\n"
+                  << "load us: mean " << load.mean << " min " << load.min << " max " << load.max << "\n"
+                  << "replay: " << (replayed == expected ? "identical" : "DIVERGED") << "\n";
+
+        if (replayed != expected || save.mean > BUDGET_US || load.mean > BUDGET_US)
+        {
+            return 1;
+        }
+    }
+    catch (const gasyboy::exception::GbException &e)
+    {
+        std::cout << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,12 @@
+#ifndef _API_ERROR_H_
+#define _API_ERROR_H_
+
+#include <string>
+
+namespace gasyboy::api
+{
+    // Message returned by gasyboy_last_error() on this thread
+    void setLastError(const std::string &message);
+}
+
+#endif
@@ -0,0 +1,630 @@
+#include "apu.h"
+#include <algorithm>
+
+namespace gasyboy
+{
+    namespace
+    {
+        // Length, sweep and envelopes are clocked at 512 Hz
+        constexpr uint64_t SEQUENCER_PERIOD = 8192;
+
+        // Frames the buffer holds, frames are closed at half of it
+        constexpr size_t BUFFER_SAMPLES = 8192;
+
+        // Four channels at full volume on both master levels stay clear of clipping after the DC filter
+        constexpr int32_t LEVEL_UNIT = 48;
+
+        // Bit n is the output of step n of the duty cycle: 12.5%, 25%, 50% and 75%
+        constexpr uint8_t DUTY_CYCLES[4] = {0x80, 0x81, 0xE1, 0x7E};
+
+        // Bits that read back as 1, write-only and unused bits included
+        constexpr uint8_t READ_MASKS[0x30] = {
+            0x80, 0x3F, 0x00, 0xFF, 0xBF,
+            0xFF, 0x3F, 0x00, 0xFF, 0xBF,
+            0x7F, 0xFF, 0x9F, 0xFF, 0xBF,
+            0xFF, 0xFF, 0x00, 0x00, 0xBF,
+            0x00, 0x00, 0x70,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    }
+
+    Apu::Apu(Utilities &utilities)
+        : _utilities(utilities),
+          _registers(),
+          _channels(),
+          _levels(),
+          _sweepShadow(0),
+          _sweepTimer(0),
+          _sweepEnabled(false),
+          _lfsr(0x7FFF),
+          _sequencerAt(SEQUENCER_PERIOD),
+          _sequencerStep(0),
+          _cycles(0),
+          _syncedAt(0),
+          _frameStart(0),
+          _flushCycles(0),
+          _sampleRate(0),
+          _rateRatio(1),
+          _buffer(BUFFER_SAMPLES, utilities.audioQuality),
+          _samples(BUFFER_SAMPLES * 2),
+          _muted(false),
+          _synthesize(false)
+    {
+        setSampleRate(DEFAULT_SAMPLE_RATE);
+        reset();
+    }
+
+    void Apu::reset()
+    {
+        // Whatever was played so far still goes out, the levels carry on from there
+        endFrame();
+
+        std::fill(std::begin(_registers), std::end(_registers), 0);
+        std::fill(std::begin(_channels), std::end(_channels), Channel());
+        _sweepShadow = 0;
+        _sweepTimer = 0;
+        _sweepEnabled = false;
+        _lfsr = 0x7FFF;
+        _sequencerAt = SEQUENCER_PERIOD;
+        _sequencerStep = 0;
+        _cycles = 0;
+        _syncedAt = 0;
+        _frameStart = 0;
+
+        // Where the BIOS leaves things, square 1 is still on with its boot sound faded out
+        if (!_utilities.executeBios)
+        {
+            _registers[NR52] = 0x80;
+            _registers[NR50] = 0x77;
+            _registers[NR51] = 0xF3;
+            _registers[NR10] = 0x80;
+            _registers[0x01] = 0xBF;
+            _registers[0x02] = 0xF3;
+            _channels[0].enabled = true;
+            _channels[0].dacEnabled = true;
+            _channels[0].nextStep = period(0);
+        }
+
+        updateLevels(_syncedAt);
+    }
+
+    void Apu::saveState(StateWriter &writer)
+    {
+        run();
+
+        writer.writeBytes(_registers, sizeof(_registers));
+        for (const auto &channel : _channels)
+        {
+            writer.writeBool(channel.enabled);
+            writer.writeBool(channel.dacEnabled);
+            writer.writeBool(channel.lengthEnabled);
+            writer.write16(static_cast<uint16_t>(channel.length));
+            writer.write16(channel.frequency);
+            writer.write64(channel.nextStep);
+            writer.write8(channel.position);
+            writer.write8(channel.volume);
+            writer.write8(channel.envelopeTimer);
+        }
+        writer.write16(_sweepShadow);
+        writer.write8(_sweepTimer);
+        writer.writeBool(_sweepEnabled);
+        writer.write16(_lfsr);
+        writer.write64(_sequencerAt);
+        writer.write8(_sequencerStep);
+        writer.write64(_cycles);
+    }
+
+    void Apu::loadState(StateReader &reader)
+    {
+        endFrame();
+
+        reader.readBytes(_registers, sizeof(_registers));
+        for (auto &channel : _channels)
+        {
+            channel.enabled = reader.readBool();
+            channel.dacEnabled = reader.readBool();
+            channel.lengthEnabled = reader.readBool();
+            channel.length = reader.read16();
+            channel.frequency = reader.read16();
+            channel.nextStep = reader.read64();
+            channel.position = reader.read8();
+            channel.volume = reader.read8();
+            channel.envelopeTimer = reader.read8();
+        }
+        _sweepShadow = reader.read16();
+        _sweepTimer = reader.read8();
+        _sweepEnabled = reader.readBool();
+        _lfsr = reader.read16();
+        _sequencerAt = reader.read64();
+        _sequencerStep = reader.read8();
+        _cycles = reader.read64();
+
+        // The buffer goes on from the levels they were at, the jump to the loaded ones is a plain step
+        _syncedAt = _cycles;
+        _frameStart = _cycles;
+        updateLevels(_syncedAt);
+    }
+
+    uint8_t Apu::read(const uint16_t &address)
+    {
+        const int index = address - 0xFF10;
+        run();
+
+        if (index == NR52)
+        {
+            uint8_t status = _registers[NR52] | READ_MASKS[NR52];
+            for (int channel = 0; channel < 4; channel++)
+            {
+                status |= _channels[channel].enabled << channel;
+            }
+            return status;
+        }
+
+        return _registers[index] | READ_MASKS[index];
+    }
+
+    void Apu::write(const uint16_t &address, const uint8_t &value)
+    {
+        const int index = address - 0xFF10;
+        run();
+
+        // Wave RAM is there whether the APU is powered or not
+        if (index >= WAVE_RAM)
+        {
+            _registers[index] = value;
+            updateLevel(2, _syncedAt);
+            return;
+        }
+
+        if (index == NR52)
+        {
+            const bool wasPowered = powered();
+            _registers[NR52] = value & 0x80;
+
+            // Powering off clears every register, powering on restarts the frame sequencer
+            if (wasPowered && !powered())
+            {
+                std::fill(_registers, _registers + NR52, 0);
+                std::fill(std::begin(_channels), std::end(_channels), Channel());
+            }
+            else if (!wasPowered && powered())
+            {
+                _sequencerStep = 0;
+                _sequencerAt = _syncedAt + SEQUENCER_PERIOD;
+            }
+
+            updateLevels(_syncedAt);
+            return;
+        }
+
+        if (!powered())
+        {
+            return;
+        }
+
+        _registers[index] = value;
+
+        // Master volume and panning
+        if (index >= NR50)
+        {
+            updateLevels(_syncedAt);
+            return;
+        }
+
+        const int channel = index / 5;
+        auto &state = _channels[channel];
+        switch (index % 5)
+        {
+        case 0:
+            if (channel == 2)
+            {
+                state.dacEnabled = value & 0x80;
+                state.enabled &= state.dacEnabled;
+            }
+            break;
+        case 1:
+            state.length = channel == 2 ? 256 - value : 64 - (value & 0x3F);
+            break;
+        case 2:
+            if (channel != 2)
+            {
+                state.dacEnabled = (value & 0xF8) != 0;
+                state.enabled &= state.dacEnabled;
+            }
+            break;
+        case 3:
+            state.frequency = (state.frequency & 0x700) | value;
+            break;
+        case 4:
+            state.frequency = (state.frequency & 0xFF) | ((value & 0x07) << 8);
+            state.lengthEnabled = value & 0x40;
+            if (value & 0x80)
+            {
+                trigger(channel);
+            }
+            break;
+        }
+
+        updateLevel(channel, _syncedAt);
+    }
+
+    void Apu::update(const uint32_t &cycles)
+    {
+        _cycles += cycles;
+        if (_cycles - _frameStart >= _flushCycles)
+        {
+            endFrame();
+        }
+    }
+
+    void Apu::endFrame()
+    {
+        run();
+
+        if (_synthesize)
+        {
+            const uint32_t time = static_cast<uint32_t>(_cycles - _frameStart);
+            _buffer.endFrame(time);
+
+            const size_t frames = _buffer.readSamples(_samples.data(), _buffer.samplesAvailable());
+            if (frames > 0)
+            {
+                _sampleHandler(_samples.data(), frames);
+            }
+        }
+
+        _frameStart = _cycles;
+    }
+
+    void Apu::setSampleRate(const int &sampleRate)
+    {
+        endFrame();
+
+        _sampleRate = sampleRate;
+        applyRates();
+    }
+
+    int Apu::getSampleRate()
+    {
+        return _sampleRate;
+    }
+
+    void Apu::setRateRatio(const double &ratio)
+    {
+        if (ratio == _rateRatio)
+        {
+            return;
+        }
+
+        // The buffer only changes rate between frames
+        endFrame();
+
+        _rateRatio = ratio;
+        applyRates();
+    }
+
+    void Apu::applyRates()
+    {
+        _buffer.setRates(CLOCK_RATE, _sampleRate * _rateRatio);
+        _flushCycles = _buffer.maxClocks() / 2;
+    }
+
+    void Apu::setSampleHandler(const std::function<void(const int16_t *, const size_t &)> &handler)
+    {
+        endFrame();
+
+        _sampleHandler = handler;
+        _synthesize = _sampleHandler && !_muted;
+
+        // The buffer starts from silence
+        _buffer.clear();
+        std::fill(std::begin(_levels), std::end(_levels), Level());
+        updateLevels(_syncedAt);
+    }
+
+    void Apu::setMuted(const bool &muted)
+    {
+        endFrame();
+
+        // Levels are left alone while muted, they still match what the buffer last got
+        _muted = muted;
+        _synthesize = _sampleHandler && !_muted;
+        updateLevels(_syncedAt);
+    }
+
+    void Apu::setQuality(const BlipBuffer::Quality &quality)
+    {
+        endFrame();
+        _buffer.setQuality(quality);
+    }
+
+    BlipBuffer::Quality Apu::getQuality()
+    {
+        return _buffer.getQuality();
+    }
+
+    bool Apu::powered()
+    {
+        return _registers[NR52] & 0x80;
+    }
+
+    uint64_t Apu::period(const int &channel)
+    {
+        switch (channel)
+        {
+        case 0:
+        case 1:
+            return (2048 - _channels[channel].frequency) * 4;
+        case 2:
+            return (2048 - _channels[channel].frequency) * 2;
+        default:
+        {
+            // The LFSR is not clocked at all with shifts 14 and 15
+            const uint8_t nr43 = _registers[NR43];
+            const uint64_t divisor = (nr43 & 0x07) ? (nr43 & 0x07) * 16 : 8;
+            const int shift = nr43 >> 4;
+            return shift < 14 ? divisor << shift : SEQUENCER_PERIOD << 16;
+        }
+        }
+    }
+
+    void Apu::run()
+    {
+        while (_syncedAt < _cycles)
+        {
+            const uint64_t until = std::min(_cycles, _sequencerAt);
+            for (int channel = 0; channel < 4; channel++)
+            {
+                runChannel(channel, until);
+            }
+            _syncedAt = until;
+
+            if (_syncedAt == _sequencerAt)
+            {
+                if (powered())
+                {
+                    clockSequencer();
+                    updateLevels(_syncedAt);
+                }
+                _sequencerAt += SEQUENCER_PERIOD;
+            }
+        }
+    }
+
+    void Apu::runChannel(const int &channel, const uint64_t &until)
+    {
+        auto &state = _channels[channel];
+        if (!state.enabled || state.nextStep > until)
+        {
+            return;
+        }
+
+        const uint64_t stepPeriod = period(channel);
+
+        // Nobody listens, the steps are counted in one go. The noise LFSR is left as is, nothing the CPU
+        // can see depends on it.
+        if (!_synthesize)
+        {
+            const uint64_t steps = (until - state.nextStep) / stepPeriod + 1;
+            state.position = static_cast<uint8_t>((state.position + steps) & (channel == 2 ? 31 : 7));
+            state.nextStep += steps * stepPeriod;
+            return;
+        }
+
+        while (state.nextStep <= until)
+        {
+            stepChannel(channel);
+            updateLevel(channel, state.nextStep);
+            state.nextStep += stepPeriod;
+        }
+    }
+
+    void Apu::stepChannel(const int &channel)
+    {
+        auto &state = _channels[channel];
+        switch (channel)
+        {
+        case 0:
+        case 1:
+            state.position = (state.position + 1) & 7;
+            break;
+        case 2:
+            state.position = (state.position + 1) & 31;
+            break;
+        default:
+        {
+            // 15 bit LFSR, or 7 bit in width mode
+            const uint16_t bit = (_lfsr ^ (_lfsr >> 1)) & 1;
+            _lfsr = (_lfsr >> 1) | (bit << 14);
+            if (_registers[NR43] & 0x08)
+            {
+                _lfsr = (_lfsr & ~0x40) | (bit << 6);
+            }
+            break;
+        }
+        }
+    }
+
+    void Apu::clockSequencer()
+    {
+        const uint8_t step = _sequencerStep;
+        _sequencerStep = (_sequencerStep + 1) & 7;
+
+        // Length counters on even steps
+        if (!(step & 1))
+        {
+            for (auto &state : _channels)
+            {
+                if (state.lengthEnabled && state.length > 0 && --state.length == 0)
+                {
+                    state.enabled = false;
+                }
+            }
+        }
+
+        // Sweep on steps 2 and 6
+        if (step == 2 || step == 6)
+        {
+            if (_sweepTimer > 0)
+            {
+                _sweepTimer--;
+            }
+            if (_sweepTimer == 0)
+            {
+                const uint8_t sweepPeriod = (_registers[NR10] >> 4) & 0x07;
+                _sweepTimer = sweepPeriod ? sweepPeriod : 8;
+
+                if (_sweepEnabled && sweepPeriod)
+                {
+                    const uint16_t target = sweepTarget();
+                    if (target > 2047)
+                    {
+                        _channels[0].enabled = false;
+                    }
+                    else if (_registers[NR10] & 0x07)
+                    {
+                        _sweepShadow = target;
+                        _channels[0].frequency = target;
+                        _registers[0x03] = target & 0xFF;
+                        _registers[0x04] = (_registers[0x04] & ~0x07) | (target >> 8);
+
+                        // The next step is checked for overflow right away
+                        if (sweepTarget() > 2047)
+                        {
+                            _channels[0].enabled = false;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Envelopes on step 7
+        if (step == 7)
+        {
+            for (const int channel : {0, 1, 3})
+            {
+                auto &state = _channels[channel];
+                const uint8_t envelope = _registers[channel * 5 + 2];
+                const uint8_t envelopePeriod = envelope & 0x07;
+                if (!envelopePeriod)
+                {
+                    continue;
+                }
+
+                if (state.envelopeTimer > 0)
+                {
+                    state.envelopeTimer--;
+                }
+                if (state.envelopeTimer == 0)
+                {
+                    state.envelopeTimer = envelopePeriod;
+                    if ((envelope & 0x08) && state.volume < 15)
+                    {
+                        state.volume++;
+                    }
+                    else if (!(envelope & 0x08) && state.volume > 0)
+                    {
+                        state.volume--;
+                    }
+                }
+            }
+        }
+    }
+
+    void Apu::trigger(const int &channel)
+    {
+        auto &state = _channels[channel];
+        state.enabled = state.dacEnabled;
+        if (state.length == 0)
+        {
+            state.length = channel == 2 ? 256 : 64;
+        }
+        state.nextStep = _syncedAt + period(channel);
+
+        const uint8_t envelope = _registers[channel * 5 + 2];
+        state.volume = envelope >> 4;
+        state.envelopeTimer = envelope & 0x07;
+
+        if (channel == 2)
+        {
+            state.position = 0;
+        }
+        else if (channel == 3)
+        {
+            _lfsr = 0x7FFF;
+        }
+        else if (channel == 0)
+        {
+            const uint8_t sweepPeriod = (_registers[NR10] >> 4) & 0x07;
+            const uint8_t sweepShift = _registers[NR10] & 0x07;
+            _sweepShadow = state.frequency;
+            _sweepTimer = sweepPeriod ? sweepPeriod : 8;
+            _sweepEnabled = sweepPeriod || sweepShift;
+            if (sweepShift && sweepTarget() > 2047)
+            {
+                state.enabled = false;
+            }
+        }
+    }
+
+    uint16_t Apu::sweepTarget()
+    {
+        const uint16_t delta = _sweepShadow >> (_registers[NR10] & 0x07);
+        return _registers[NR10] & 0x08 ? _sweepShadow - delta : _sweepShadow + delta;
+    }
+
+    int Apu::amplitude(const int &channel)
+    {
+        const auto &state = _channels[channel];
+        if (!state.enabled || !state.dacEnabled)
+        {
+            return 0;
+        }
+
+        switch (channel)
+        {
+        case 0:
+        case 1:
+            return (DUTY_CYCLES[_registers[channel * 5 + 1] >> 6] >> state.position) & 1 ? state.volume : 0;
+        case 2:
+        {
+            // Two samples per byte, high nibble first, shifted down by the output level of NR32
+            static constexpr int shifts[4] = {4, 0, 1, 2};
+            const uint8_t sample = _registers[WAVE_RAM + state.position / 2];
+            const uint8_t nibble = state.position & 1 ? sample & 0x0F : sample >> 4;
+            return nibble >> shifts[(_registers[NR32] >> 5) & 0x03];
+        }
+        default:
+            return (~_lfsr & 1) ? state.volume : 0;
+        }
+    }
+
+    void Apu::updateLevel(const int &channel, const uint64_t &time)
+    {
+        if (!_synthesize)
+        {
+            return;
+        }
+
+        const int value = amplitude(channel);
+        const uint8_t panning = _registers[NR51];
+        const int32_t left = (panning >> (channel + 4)) & 1 ? value * (((_registers[NR50] >> 4) & 0x07) + 1) * LEVEL_UNIT : 0;
+        const int32_t right = (panning >> channel) & 1 ? value * ((_registers[NR50] & 0x07) + 1) * LEVEL_UNIT : 0;
+
+        // Both sides go into the buffer at once
+        auto &level = _levels[channel];
+        if (left != level.left || right != level.right)
+        {
+            _buffer.addDelta(static_cast<uint32_t>(time - _frameStart), left - level.left, right - level.right);
+            level.left = left;
+            level.right = right;
+        }
+    }
+
+    void Apu::updateLevels(const uint64_t &time)
+    {
+        for (int channel = 0; channel < 4; channel++)
+        {
+            updateLevel(channel, time);
+        }
+    }
+}
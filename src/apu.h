@@ -0,0 +1,158 @@
+#ifndef _APU_H_
+#define _APU_H_
+
+#include "blipBuffer.h"
+#include "saveState.h"
+#include "utilities.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace gasyboy
+{
+    // Four channel sound unit: two squares (the first one with a frequency sweep), a wave and a noise channel.
+    // Like the timer it only counts cycles per instruction. The channels are caught up to the current cycle
+    // when a register is accessed or a frame ends, each level change going into a stereo band-limited
+    // buffer, so the cost follows the waveform edges rather than the 4 MHz clock.
+    class Apu
+    {
+    public:
+        static constexpr double CLOCK_RATE = 4194304;
+        static constexpr int DEFAULT_SAMPLE_RATE = 48000;
+
+        Apu(Utilities &utilities);
+        ~Apu() = default;
+
+        void reset();
+
+        // Save state, the samples not handed over yet are not part of it
+        void saveState(StateWriter &writer);
+        void loadState(StateReader &reader);
+
+        // 0xFF10 to 0xFF3F
+        uint8_t read(const uint16_t &address);
+        void write(const uint16_t &address, const uint8_t &value);
+
+        // Advance by the cycles of the last instruction
+        void update(const uint32_t &cycles);
+
+        // Catch up and hand the samples of the cycles run so far to the sample handler
+        void endFrame();
+
+        void setSampleRate(const int &sampleRate);
+        int getSampleRate();
+
+        // Samples are produced at the sample rate times this ratio, bent slightly to follow the audio device
+        void setRateRatio(const double &ratio);
+
+        // Receives interleaved 16 bit stereo frames, nothing is synthesized without a handler
+        void setSampleHandler(const std::function<void(const int16_t *, const size_t &)> &handler);
+
+        // Channels keep running without producing samples, for frames that are thrown away
+        void setMuted(const bool &muted);
+
+        // Kernel of the band-limited synthesis, changes from now on use the new one
+        void setQuality(const BlipBuffer::Quality &quality);
+        BlipBuffer::Quality getQuality();
+
+    private:
+        // Offsets from 0xFF10 of the registers referred to by name
+        enum Register
+        {
+            NR10 = 0x00,
+            NR32 = 0x0C,
+            NR43 = 0x12,
+            NR50 = 0x14,
+            NR51 = 0x15,
+            NR52 = 0x16,
+            WAVE_RAM = 0x20
+        };
+
+        struct Channel
+        {
+            // Reported in NR52, cleared by the length counter, the sweep or the DAC going off
+            bool enabled;
+            bool dacEnabled;
+
+            bool lengthEnabled;
+            int length;
+
+            uint16_t frequency;
+
+            // Cycle of the next step through the duty cycle, wave RAM or noise LFSR
+            uint64_t nextStep;
+            uint8_t position;
+
+            uint8_t volume;
+            uint8_t envelopeTimer;
+        };
+
+        // Level last sent to the buffer for a channel, follows the output rather than the state
+        struct Level
+        {
+            int32_t left;
+            int32_t right;
+        };
+
+        Utilities &_utilities;
+
+        // NR10 to NR52 and wave RAM, channel n has its five registers from n * 5
+        uint8_t _registers[0x30];
+
+        Channel _channels[4];
+        Level _levels[4];
+
+        // Square 1 sweep
+        uint16_t _sweepShadow;
+        uint8_t _sweepTimer;
+        bool _sweepEnabled;
+
+        uint16_t _lfsr;
+
+        // 512 Hz frame sequencer clocking length counters, sweep and envelopes
+        uint64_t _sequencerAt;
+        uint8_t _sequencerStep;
+
+        // Cycles since reset, how far the channels have been run, and where the current buffer frame started
+        uint64_t _cycles;
+        uint64_t _syncedAt;
+        uint64_t _frameStart;
+
+        // Frames are closed before they outgrow the buffer
+        uint64_t _flushCycles;
+
+        int _sampleRate;
+        double _rateRatio;
+        BlipBuffer _buffer;
+        std::vector<int16_t> _samples;
+        std::function<void(const int16_t *, const size_t &)> _sampleHandler;
+        bool _muted;
+        bool _synthesize;
+
+        bool powered();
+
+        // Set the buffer up for the sample rate and ratio
+        void applyRates();
+
+        // Cycles between steps of a channel's waveform
+        uint64_t period(const int &channel);
+
+        // Run the channels and the frame sequencer up to _cycles
+        void run();
+        void runChannel(const int &channel, const uint64_t &until);
+        void stepChannel(const int &channel);
+        void clockSequencer();
+
+        void trigger(const int &channel);
+        uint16_t sweepTarget();
+
+        // Digital output of a channel, 0 to 15
+        int amplitude(const int &channel);
+
+        // Send the level changes of a channel, or of all of them, to the buffer
+        void updateLevel(const int &channel, const uint64_t &time);
+        void updateLevels(const uint64_t &time);
+    };
+}
+
+#endif
@@ -0,0 +1,89 @@
+#include "audioPacer.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace gasyboy
+{
+    namespace
+    {
+        // The device pulls whole buffers at once, the level read after each frame jumps by that much
+        constexpr double SMOOTHING = 32;
+
+        // The drift follows a constant fill error over about ten seconds of frames
+        constexpr double DRIFT_FRAMES = 600;
+    }
+
+    AudioPacer::AudioPacer()
+        : _target(0),
+          _frameSamples(0),
+          _displayPaced(false),
+          _error(0),
+          _started(false),
+          _drift(0),
+          _ratio(1)
+    {
+    }
+
+    void AudioPacer::setup(const size_t &target, const double &frameSamples, const bool &displayPaced)
+    {
+        _target = target;
+        _frameSamples = frameSamples;
+        _displayPaced = displayPaced;
+        reset();
+    }
+
+    void AudioPacer::reset()
+    {
+        _error = 0;
+        _started = false;
+        _drift = 0;
+        _ratio = 1;
+    }
+
+    double AudioPacer::wait(const std::function<size_t()> &queued)
+    {
+        if (_target == 0)
+        {
+            return _ratio;
+        }
+
+        const size_t level = queued();
+        const double error = (static_cast<double>(level) - _target) / _target;
+        _error = _started ? _error + (error - _error) / SMOOTHING : error;
+        _started = true;
+
+        // Blocking keeps the queue at the target by itself, only vsync needs the rate bent.
+        // Too full, fewer samples per emulated second, and the other way around.
+        if (_displayPaced)
+        {
+            // The drift is only learnt while the correction is in range, filling up from empty says nothing about the clocks
+            const double correction = _drift + _error * MAX_RATE_ADJUSTMENT;
+            if (std::abs(correction) < MAX_RATE_ADJUSTMENT)
+            {
+                _drift += _error * MAX_RATE_ADJUSTMENT / DRIFT_FRAMES;
+            }
+            _ratio = 1 - std::clamp(correction, -MAX_RATE_ADJUSTMENT, MAX_RATE_ADJUSTMENT);
+        }
+
+        // Past the target, or with vsync only when the next frame would no longer fit
+        const double limit = _displayPaced ? 2.0 * _target - _frameSamples : _target;
+        const auto giveUp = Clock::now() + std::chrono::milliseconds(MAX_WAIT_MS);
+        while (static_cast<double>(queued()) > limit && Clock::now() < giveUp)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        return _ratio;
+    }
+
+    double AudioPacer::getRatio()
+    {
+        return _ratio;
+    }
+
+    double AudioPacer::getAverageFill()
+    {
+        return _target + _error * _target;
+    }
+}
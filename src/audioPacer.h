@@ -0,0 +1,59 @@
+#ifndef _AUDIO_PACER_H_
+#define _AUDIO_PACER_H_
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+
+namespace gasyboy
+{
+    // Paces frames against the audio device instead of a timer. After each frame it blocks while the
+    // device queue holds more than the target, so emulation runs exactly as fast as the sound card
+    // drains it and nothing drifts.
+    // When vsync paces the frames instead, the two clocks disagree by a fraction of a percent. Only
+    // a full queue blocks then, and the sample rate is bent by up to MAX_RATE_ADJUSTMENT from the
+    // smoothed fill error to hold the queue at the target, well below an audible change of pitch.
+    class AudioPacer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr double MAX_RATE_ADJUSTMENT = 0.005;
+
+        // A device that stopped pulling samples does not hold a frame longer than this
+        static constexpr int MAX_WAIT_MS = 50;
+
+        AudioPacer();
+        ~AudioPacer() = default;
+
+        // Stereo frames to keep queued, how many one emulated frame adds, and whether the display paces the frames
+        void setup(const size_t &target, const double &frameSamples, const bool &displayPaced);
+
+        // Forget the fill history, e.g. after a pause
+        void reset();
+
+        // Block while the queue is above the target, returns the sample rate ratio for the next frame
+        double wait(const std::function<size_t()> &queued);
+
+        double getRatio();
+
+        // Smoothed queue level, in stereo frames
+        double getAverageFill();
+
+    private:
+        size_t _target;
+        double _frameSamples;
+        bool _displayPaced;
+
+        // Fill error relative to the target, averaged over a few dozen frames
+        double _error;
+        bool _started;
+
+        // Steady rate mismatch between the display and the device, learnt from the accumulated error
+        double _drift;
+
+        double _ratio;
+    };
+}
+
+#endif
@@ -0,0 +1,392 @@
+#include "batchRunner.h"
+#include "nullFrontend.h"
+#include "gbException.h"
+#include "gameboy.h"
+#include "utils.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace gasyboy
+{
+    namespace
+    {
+        std::string escapeJson(const std::string &text)
+        {
+            std::ostringstream out;
+            for (const unsigned char c : text)
+            {
+                switch (c)
+                {
+                case '"':
+                    out << "\\\"";
+                    break;
+                case '\\':
+                    out << "\\\\";
+                    break;
+                case '\n':
+                    out << "\\n";
+                    break;
+                case '\r':
+                    out << "\\r";
+                    break;
+                case '\t':
+                    out << "\\t";
+                    break;
+                default:
+                    if (c < 0x20 || c >= 0x7F)
+                        out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+                    else
+                        out << c;
+                }
+            }
+            return out.str();
+        }
+
+        std::string escapeXml(const std::string &text)
+        {
+            std::ostringstream out;
+            for (const unsigned char c : text)
+            {
+                switch (c)
+                {
+                case '"':
+                    out << "&quot;";
+                    break;
+                case '&':
+                    out << "&amp;";
+                    break;
+                case '<':
+                    out << "&lt;";
+                    break;
+                case '>':
+                    out << "&gt;";
+                    break;
+                default:
+                    // XML 1.0 has no way to carry other control characters
+                    if ((c < 0x20 && c != '\n' && c != '\t') || c >= 0x7F)
+                        out << '?';
+                    else
+                        out << c;
+                }
+            }
+            return out.str();
+        }
+    }
+
+    double BatchResult::cyclesPerSecond() const
+    {
+        return seconds > 0 ? cycles / seconds : 0;
+    }
+
+    std::string BatchResult::statusStr(const Status &status)
+    {
+        switch (status)
+        {
+        case Status::PASSED:
+            return "passed";
+        case Status::FAILED:
+            return "failed";
+        case Status::TIMEOUT:
+            return "timeout";
+        default:
+            return "error";
+        }
+    }
+
+    BatchRunner::BatchRunner(const std::vector<BatchEntry> &entries, const int &jobs)
+        : _entries(entries),
+          _jobs(jobs)
+    {
+        if (_jobs <= 0)
+        {
+            _jobs = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        }
+    }
+
+    std::vector<BatchResult> BatchRunner::run()
+    {
+        std::vector<BatchResult> results(_entries.size());
+        std::atomic<size_t> next = 0;
+
+        // Workers pick the next ROM as soon as they are done, long tests do not hold up the others
+        std::vector<std::thread> workers;
+        const int workerCount = std::min(_jobs, static_cast<int>(_entries.size()));
+        for (int i = 0; i < workerCount; i++)
+        {
+            workers.emplace_back([&]()
+                                 {
+                for (size_t index = next++; index < _entries.size(); index = next++)
+                {
+                    results[index] = runEntry(_entries[index]);
+                } });
+        }
+
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+
+        return results;
+    }
+
+    BatchResult BatchRunner::runEntry(const BatchEntry &entry)
+    {
+        BatchResult result;
+        result.romPath = entry.romPath;
+
+        if (!std::filesystem::is_regular_file(entry.romPath))
+        {
+            result.message = "ROM file not found";
+            return result;
+        }
+
+        auto utilities = std::make_shared<Utilities>();
+        utilities->romFilePath = entry.romPath;
+        utilities->executeBios = entry.executeBios;
+        utilities->threadedEmulation = false;
+        utilities->speed = GameBoy::SPEED_UNCAPPED;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        try
+        {
+            auto gameboy = std::make_unique<GameBoy>(utilities,
+                                                     std::make_unique<NullRenderer>(),
+                                                     std::make_unique<NullInputHandler>());
+
+            std::string &serial = result.serialOutput;
+            gameboy->getMmu().setSerialHandler([&serial](const uint8_t &value)
+                                               { serial.push_back(static_cast<char>(value)); });
+
+            // Only the new output, plus enough before it for a pattern split across frames, is searched
+            size_t searchFrom = 0;
+            const size_t overlap = std::max(entry.passPattern.size(), entry.failPattern.size());
+
+            auto &ppu = gameboy->getPpu();
+            while (true)
+            {
+                gameboy->loop();
+
+                if (serial.size() > searchFrom)
+                {
+                    if (!entry.failPattern.empty() && serial.find(entry.failPattern, searchFrom) != std::string::npos)
+                    {
+                        result.status = BatchResult::Status::FAILED;
+                        result.message = "fail pattern found in serial output";
+                        break;
+                    }
+                    if (!entry.passPattern.empty() && serial.find(entry.passPattern, searchFrom) != std::string::npos)
+                    {
+                        result.status = BatchResult::Status::PASSED;
+                        result.message = "pass pattern found in serial output";
+                        break;
+                    }
+                    searchFrom = serial.size() > overlap ? serial.size() - overlap : 0;
+                }
+
+                if (entry.hasFrameHash && utils::hash64(ppu._framebuffer, sizeof(ppu._framebuffer)) == entry.frameHash)
+                {
+                    result.status = BatchResult::Status::PASSED;
+                    result.message = "frame hash matched";
+                    break;
+                }
+
+                if (gameboy->getCycleCount() >= entry.cycleBudget)
+                {
+                    result.status = BatchResult::Status::TIMEOUT;
+                    result.message = "cycle budget exhausted";
+                    break;
+                }
+            }
+
+            result.cycles = gameboy->getCycleCount();
+        }
+        catch (const std::exception &e)
+        {
+            result.status = BatchResult::Status::CRASHED;
+            result.message = e.what();
+        }
+
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    std::vector<BatchEntry> BatchRunner::loadManifest(const std::string &manifestPath)
+    {
+        std::ifstream file(manifestPath);
+        if (!file.is_open())
+        {
+            throw exception::GbException("Unable to open batch manifest: " + manifestPath);
+        }
+
+        const auto baseDir = std::filesystem::path(manifestPath).parent_path();
+
+        std::vector<BatchEntry> entries;
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(file, line))
+        {
+            lineNumber++;
+
+            const auto comment = line.find('#');
+            if (comment != std::string::npos)
+            {
+                line.erase(comment);
+            }
+
+            std::istringstream tokens(line);
+            std::string token;
+            if (!(tokens >> token))
+            {
+                continue;
+            }
+
+            BatchEntry entry;
+            auto romPath = std::filesystem::path(token);
+            entry.romPath = (romPath.is_relative() ? baseDir / romPath : romPath).make_preferred().string();
+
+            while (tokens >> token)
+            {
+                const auto separator = token.find('=');
+                const std::string key = token.substr(0, separator);
+                const std::string value = separator == std::string::npos ? "" : token.substr(separator + 1);
+
+                try
+                {
+                    if (key == "pass")
+                        entry.passPattern = value;
+                    else if (key == "fail")
+                        entry.failPattern = value;
+                    else if (key == "cycles")
+                        entry.cycleBudget = std::stoull(value);
+                    else if (key == "hash")
+                    {
+                        entry.frameHash = std::stoull(value, nullptr, 16);
+                        entry.hasFrameHash = true;
+                    }
+                    else if (key == "bios")
+                        entry.executeBios = true;
+                    else
+                        throw exception::GbException("unknown option \"" + key + "\"");
+                }
+                catch (const std::logic_error &)
+                {
+                    throw exception::GbException(manifestPath + ":" + std::to_string(lineNumber) + ": invalid value for \"" + key + "\"");
+                }
+                catch (const exception::GbException &e)
+                {
+                    throw exception::GbException(manifestPath + ":" + std::to_string(lineNumber) + ": " + e.what());
+                }
+            }
+
+            entries.push_back(entry);
+        }
+
+        return entries;
+    }
+
+    std::string BatchRunner::toJson(const std::vector<BatchResult> &results)
+    {
+        std::ostringstream out;
+        out << "{\n  \"results\": [";
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const auto &result = results[i];
+            out << (i ? ",\n" : "\n")
+                << "    {\n"
+                << "      \"rom\": \"" << escapeJson(result.romPath) << "\",\n"
+                << "      \"status\": \"" << BatchResult::statusStr(result.status) << "\",\n"
+                << "      \"message\": \"" << escapeJson(result.message) << "\",\n"
+                << "      \"cycles\": " << result.cycles << ",\n"
+                << "      \"seconds\": " << result.seconds << ",\n"
+                << "      \"cycles_per_second\": " << std::fixed << std::setprecision(0) << result.cyclesPerSecond() << std::defaultfloat << std::setprecision(6) << ",\n"
+                << "      \"serial\": \"" << escapeJson(result.serialOutput) << "\"\n"
+                << "    }";
+        }
+        out << "\n  ]\n}\n";
+        return out.str();
+    }
+
+    std::string BatchRunner::toJUnit(const std::vector<BatchResult> &results)
+    {
+        int failures = 0;
+        int errors = 0;
+        double seconds = 0;
+        for (const auto &result : results)
+        {
+            failures += result.status == BatchResult::Status::FAILED || result.status == BatchResult::Status::TIMEOUT;
+            errors += result.status == BatchResult::Status::CRASHED;
+            seconds += result.seconds;
+        }
+
+        std::ostringstream out;
+        out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            << "<testsuite name=\"gasyboy\" tests=\"" << results.size() << "\" failures=\"" << failures
+            << "\" errors=\"" << errors << "\" time=\"" << seconds << "\">\n";
+
+        for (const auto &result : results)
+        {
+            out << "  <testcase name=\"" << escapeXml(result.romPath) << "\" time=\"" << result.seconds << "\">\n"
+                << "    <properties>\n"
+                << "      <property name=\"cycles\" value=\"" << result.cycles << "\"/>\n"
+                << "      <property name=\"cycles_per_second\" value=\"" << std::fixed << std::setprecision(0) << result.cyclesPerSecond() << std::defaultfloat << std::setprecision(6) << "\"/>\n"
+                << "    </properties>\n";
+
+            if (result.status == BatchResult::Status::FAILED || result.status == BatchResult::Status::TIMEOUT)
+            {
+                out << "    <failure message=\"" << escapeXml(result.message) << "\"/>\n";
+            }
+            else if (result.status == BatchResult::Status::CRASHED)
+            {
+                out << "    <error message=\"" << escapeXml(result.message) << "\"/>\n";
+            }
+
+            out << "    <system-out>" << escapeXml(result.serialOutput) << "</system-out>\n"
+                << "  </testcase>\n";
+        }
+
+        out << "</testsuite>\n";
+        return out.str();
+    }
+
+    int BatchRunner::runManifest(const std::string &manifestPath, const std::string &reportPath, const int &jobs)
+    {
+        const auto entries = loadManifest(manifestPath);
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto results = BatchRunner(entries, jobs).run();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        int passed = 0;
+        for (const auto &result : results)
+        {
+            passed += result.status == BatchResult::Status::PASSED;
+            std::cout << std::left << std::setw(8) << BatchResult::statusStr(result.status) << std::right
+                      << result.romPath << " (" << result.message << ", "
+                      << std::fixed << std::setprecision(1) << result.cyclesPerSecond() / 1e6 << std::defaultfloat << std::setprecision(6)
+                      << " Mcycles/s)\n";
+        }
+        std::cout << passed << "/" << results.size() << " passed in " << seconds << " s\n";
+
+        if (!reportPath.empty())
+        {
+            std::ofstream report(reportPath);
+            if (!report.is_open())
+            {
+                throw exception::GbException("Unable to write batch report: " + reportPath);
+            }
+
+            const bool junit = std::filesystem::path(reportPath).extension() == ".xml";
+            report << (junit ? toJUnit(results) : toJson(results));
+        }
+
+        return passed == static_cast<int>(results.size()) ? 0 : 1;
+    }
+}
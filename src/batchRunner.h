@@ -0,0 +1,80 @@
+#ifndef _BATCH_RUNNER_H_
+#define _BATCH_RUNNER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gasyboy
+{
+    // A test ROM to run and how to tell when it is done
+    struct BatchEntry
+    {
+        std::string romPath;
+
+        // Serial output that ends the run, Blargg tests print these
+        std::string passPattern = "Passed";
+        std::string failPattern = "Failed";
+
+        // Emulated cycles before giving up, 60 seconds by default
+        uint64_t cycleBudget = 60ull * 4194304;
+
+        // Passes as soon as a frame hashes to this value
+        bool hasFrameHash = false;
+        uint64_t frameHash = 0;
+
+        bool executeBios = false;
+    };
+
+    struct BatchResult
+    {
+        enum class Status
+        {
+            PASSED,
+            FAILED,
+            TIMEOUT,
+            CRASHED
+        };
+
+        std::string romPath;
+        Status status = Status::CRASHED;
+        std::string message;
+        std::string serialOutput;
+        uint64_t cycles = 0;
+        double seconds = 0;
+
+        // Emulated cycles per second of wall time
+        double cyclesPerSecond() const;
+
+        static std::string statusStr(const Status &status);
+    };
+
+    // Runs test ROMs headless, several at once, each in its own GameBoy instance
+    class BatchRunner
+    {
+        std::vector<BatchEntry> _entries;
+        int _jobs;
+
+        BatchResult runEntry(const BatchEntry &entry);
+
+    public:
+        // 0 jobs uses every core
+        BatchRunner(const std::vector<BatchEntry> &entries, const int &jobs = 0);
+
+        // Results come back in manifest order
+        std::vector<BatchResult> run();
+
+        // One ROM per line: path [pass=text] [fail=text] [cycles=n] [hash=hex] [bios], # starts a comment.
+        // Relative paths are relative to the manifest.
+        static std::vector<BatchEntry> loadManifest(const std::string &manifestPath);
+
+        static std::string toJson(const std::vector<BatchResult> &results);
+        static std::string toJUnit(const std::vector<BatchResult> &results);
+
+        // Run a manifest, print a line per ROM and write the report (JUnit for .xml, JSON otherwise).
+        // Returns 0 when every ROM passed.
+        static int runManifest(const std::string &manifestPath, const std::string &reportPath, const int &jobs);
+    };
+}
+
+#endif
@@ -0,0 +1,289 @@
+#include "blipBuffer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+
+#if defined(GASYBOY_NO_SIMD)
+#elif defined(__AVX2__)
+#define BLIP_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BLIP_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define BLIP_NEON
+#include <arm_neon.h>
+#endif
+
+namespace gasyboy
+{
+    namespace
+    {
+        struct Preset
+        {
+            int kernelWidth;
+            int phaseBits;
+
+            // Low pass at this fraction of the Nyquist frequency, shorter kernels need a wider transition band
+            double cutoff;
+        };
+
+        constexpr Preset PRESETS[] = {
+            {8, 5, 0.7},
+            {16, 5, 0.9},
+            {BlipBuffer::MAX_KERNEL_WIDTH, 6, 0.95}};
+
+        // The high-pass taking DC out decays by 1 / (1 << BASS_SHIFT) per sample, about 15 Hz at 48 kHz
+        constexpr int BASS_SHIFT = 9;
+
+        // Blackman windowed sinc impulse for each sub-sample phase, centered between taps
+        // width / 2 - 1 and width / 2, every tap stored twice
+        std::vector<int16_t> makeKernel(const Preset &preset)
+        {
+            const int width = preset.kernelWidth;
+            const int phases = 1 << preset.phaseBits;
+            const double half = width / 2;
+
+            std::vector<int16_t> kernel(static_cast<size_t>(phases * width * 2));
+            std::vector<double> taps(width);
+            std::vector<int32_t> rounded(width);
+
+            for (int phase = 0; phase < phases; phase++)
+            {
+                double sum = 0;
+                for (int i = 0; i < width; i++)
+                {
+                    const double t = i - (half - 1) - static_cast<double>(phase) / phases;
+                    const double x = std::numbers::pi * preset.cutoff * t;
+                    const double sinc = t == 0 ? 1 : std::sin(x) / x;
+                    const double window = 0.42 + 0.5 * std::cos(std::numbers::pi * t / half) + 0.08 * std::cos(2 * std::numbers::pi * t / half);
+                    taps[i] = sinc * window;
+                    sum += taps[i];
+                }
+
+                // Every phase sums to exactly 1 << KERNEL_BITS, steps integrate back to their full height
+                int32_t total = 0;
+                for (int i = 0; i < width; i++)
+                {
+                    rounded[i] = static_cast<int32_t>(std::lround(taps[i] / sum * (1 << BlipBuffer::KERNEL_BITS)));
+                    total += rounded[i];
+                }
+                rounded[width / 2 - 1] += (1 << BlipBuffer::KERNEL_BITS) - total;
+
+                int16_t *out = kernel.data() + phase * width * 2;
+                for (int i = 0; i < width; i++)
+                {
+                    out[i * 2] = static_cast<int16_t>(rounded[i]);
+                    out[i * 2 + 1] = static_cast<int16_t>(rounded[i]);
+                }
+            }
+
+            return kernel;
+        }
+
+        // out[i] += taps[i] * (left or right), count is a multiple of 16
+        void accumulate(int32_t *out, const int16_t *taps, const int &count, const int16_t &left, const int16_t &right)
+        {
+#if defined(BLIP_AVX2)
+            // 16 bit products put back together as in SSE2, the unpacks work within 128 bit lanes
+            const __m256i deltas = _mm256_setr_epi16(left, right, left, right, left, right, left, right,
+                                                     left, right, left, right, left, right, left, right);
+            for (int i = 0; i < count; i += 16)
+            {
+                const __m256i kernel = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(taps + i));
+                const __m256i low = _mm256_mullo_epi16(kernel, deltas);
+                const __m256i high = _mm256_mulhi_epi16(kernel, deltas);
+                const __m256i first = _mm256_unpacklo_epi16(low, high);
+                const __m256i second = _mm256_unpackhi_epi16(low, high);
+                __m256i *sums = reinterpret_cast<__m256i *>(out + i);
+                _mm256_storeu_si256(sums, _mm256_add_epi32(_mm256_loadu_si256(sums), _mm256_permute2x128_si256(first, second, 0x20)));
+                _mm256_storeu_si256(sums + 1, _mm256_add_epi32(_mm256_loadu_si256(sums + 1), _mm256_permute2x128_si256(first, second, 0x31)));
+            }
+#elif defined(BLIP_SSE2)
+            // No 32 bit multiply in SSE2, the low and high halves of the 16 bit products are interleaved back
+            const __m128i deltas = _mm_setr_epi16(left, right, left, right, left, right, left, right);
+            for (int i = 0; i < count; i += 8)
+            {
+                const __m128i kernel = _mm_loadu_si128(reinterpret_cast<const __m128i *>(taps + i));
+                const __m128i low = _mm_mullo_epi16(kernel, deltas);
+                const __m128i high = _mm_mulhi_epi16(kernel, deltas);
+                __m128i *sums = reinterpret_cast<__m128i *>(out + i);
+                _mm_storeu_si128(sums, _mm_add_epi32(_mm_loadu_si128(sums), _mm_unpacklo_epi16(low, high)));
+                _mm_storeu_si128(sums + 1, _mm_add_epi32(_mm_loadu_si128(sums + 1), _mm_unpackhi_epi16(low, high)));
+            }
+#elif defined(BLIP_NEON)
+            const int16_t pair[4] = {left, right, left, right};
+            const int16x4_t deltas = vld1_s16(pair);
+            for (int i = 0; i < count; i += 4)
+            {
+                vst1q_s32(out + i, vmlal_s16(vld1q_s32(out + i), vld1_s16(taps + i), deltas));
+            }
+#else
+            for (int i = 0; i < count; i += 2)
+            {
+                out[i] += taps[i] * left;
+                out[i + 1] += taps[i + 1] * right;
+            }
+#endif
+        }
+
+        // Integrate count interleaved frames into saturated 16 bit samples
+        void integrate(int16_t *out, const int32_t *in, const size_t &count, int32_t *integrator)
+        {
+#if defined(BLIP_AVX2) || defined(BLIP_SSE2)
+            __m128i sums = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(integrator));
+            for (size_t i = 0; i < count; i++)
+            {
+                sums = _mm_add_epi32(sums, _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in + i * 2)));
+                const __m128i sample = _mm_srai_epi32(sums, BlipBuffer::KERNEL_BITS);
+                const int32_t frame = _mm_cvtsi128_si32(_mm_packs_epi32(sample, sample));
+                std::memcpy(out + i * 2, &frame, sizeof(frame));
+                sums = _mm_sub_epi32(sums, _mm_slli_epi32(sample, BlipBuffer::KERNEL_BITS - BASS_SHIFT));
+            }
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(integrator), sums);
+#elif defined(BLIP_NEON)
+            int32x2_t sums = vld1_s32(integrator);
+            for (size_t i = 0; i < count; i++)
+            {
+                sums = vadd_s32(sums, vld1_s32(in + i * 2));
+                const int32x2_t sample = vshr_n_s32(sums, BlipBuffer::KERNEL_BITS);
+                const int32_t frame = vget_lane_s32(vreinterpret_s32_s16(vqmovn_s32(vcombine_s32(sample, sample))), 0);
+                std::memcpy(out + i * 2, &frame, sizeof(frame));
+                sums = vsub_s32(sums, vshl_n_s32(sample, BlipBuffer::KERNEL_BITS - BASS_SHIFT));
+            }
+            vst1_s32(integrator, sums);
+#else
+            int32_t left = integrator[0];
+            int32_t right = integrator[1];
+            for (size_t i = 0; i < count; i++)
+            {
+                left += in[i * 2];
+                right += in[i * 2 + 1];
+                const int32_t leftSample = left >> BlipBuffer::KERNEL_BITS;
+                const int32_t rightSample = right >> BlipBuffer::KERNEL_BITS;
+                out[i * 2] = static_cast<int16_t>(std::clamp<int32_t>(leftSample, INT16_MIN, INT16_MAX));
+                out[i * 2 + 1] = static_cast<int16_t>(std::clamp<int32_t>(rightSample, INT16_MIN, INT16_MAX));
+                left -= leftSample << (BlipBuffer::KERNEL_BITS - BASS_SHIFT);
+                right -= rightSample << (BlipBuffer::KERNEL_BITS - BASS_SHIFT);
+            }
+            integrator[0] = left;
+            integrator[1] = right;
+#endif
+        }
+    }
+
+    BlipBuffer::BlipBuffer(const size_t &capacity, const Quality &quality)
+        : _buffer((capacity + MAX_KERNEL_WIDTH) * 2, 0),
+          _capacity(capacity),
+          _quality(quality),
+          _kernelWidth(0),
+          _phaseBits(0),
+          _factor(0),
+          _offset(0),
+          _integrator{0, 0}
+    {
+        setQuality(quality);
+    }
+
+    void BlipBuffer::setRates(const double &clockRate, const double &sampleRate)
+    {
+        _factor = static_cast<uint64_t>(std::llround(sampleRate / clockRate * static_cast<double>(1ull << TIME_BITS)));
+    }
+
+    void BlipBuffer::setQuality(const Quality &quality)
+    {
+        const Preset &preset = PRESETS[static_cast<int>(quality)];
+        _quality = quality;
+        _kernelWidth = preset.kernelWidth;
+        _phaseBits = preset.phaseBits;
+        _kernel = makeKernel(preset);
+    }
+
+    BlipBuffer::Quality BlipBuffer::getQuality()
+    {
+        return _quality;
+    }
+
+    uint64_t BlipBuffer::maxClocks()
+    {
+        return _factor ? (static_cast<uint64_t>(_capacity) << TIME_BITS) / _factor : 0;
+    }
+
+    void BlipBuffer::clear()
+    {
+        std::fill(_buffer.begin(), _buffer.end(), 0);
+        _offset = 0;
+        _integrator[0] = 0;
+        _integrator[1] = 0;
+    }
+
+    void BlipBuffer::addDelta(const uint32_t &time, const int32_t &left, const int32_t &right)
+    {
+        const uint64_t fixed = time * _factor + _offset;
+        const size_t index = static_cast<size_t>(fixed >> TIME_BITS);
+        if (index > _capacity)
+        {
+            return;
+        }
+
+        const size_t phase = (fixed >> (TIME_BITS - _phaseBits)) & ((1 << _phaseBits) - 1);
+        accumulate(_buffer.data() + index * 2, _kernel.data() + phase * _kernelWidth * 2, _kernelWidth * 2,
+                   static_cast<int16_t>(left), static_cast<int16_t>(right));
+    }
+
+    void BlipBuffer::endFrame(const uint32_t &time)
+    {
+        _offset += time * _factor;
+    }
+
+    size_t BlipBuffer::samplesAvailable()
+    {
+        return std::min(static_cast<size_t>(_offset >> TIME_BITS), _capacity);
+    }
+
+    size_t BlipBuffer::readSamples(int16_t *out, const size_t &count)
+    {
+        const size_t available = samplesAvailable();
+        const size_t read = std::min(count, available);
+
+        integrate(out, _buffer.data(), read, _integrator);
+
+        // Impulses reaching past the samples read are kept for the next read
+        const size_t remaining = (available - read + MAX_KERNEL_WIDTH) * 2;
+        std::memmove(_buffer.data(), _buffer.data() + read * 2, remaining * sizeof(int32_t));
+        std::fill(_buffer.begin() + remaining, _buffer.begin() + remaining + read * 2, 0);
+        _offset -= static_cast<uint64_t>(read) << TIME_BITS;
+
+        return read;
+    }
+
+    bool BlipBuffer::parseQuality(const std::string &name, Quality &quality)
+    {
+        static const std::pair<const char *, Quality> names[] = {
+            {"low", Quality::LOW}, {"medium", Quality::MEDIUM}, {"high", Quality::HIGH}};
+
+        for (const auto &[text, value] : names)
+        {
+            if (name == text)
+            {
+                quality = value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const char *BlipBuffer::instructionSet()
+    {
+#if defined(BLIP_AVX2)
+        return "AVX2";
+#elif defined(BLIP_SSE2)
+        return "SSE2";
+#elif defined(BLIP_NEON)
+        return "NEON";
+#else
+        return "scalar";
+#endif
+    }
+}
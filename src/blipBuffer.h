@@ -0,0 +1,89 @@
+#ifndef _BLIP_BUFFER_H_
+#define _BLIP_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gasyboy
+{
+    // Band-limited step synthesis: a stereo waveform is given as amplitude changes at clock times and
+    // comes out at the sample rate without aliasing. Each change adds one phase of a polyphase windowed
+    // sinc FIR to the buffer, reading integrates it back into steps, so the cost follows the number of
+    // changes and not the clock rate. Both sides are kept interleaved and go through SSE2, AVX2 or NEON
+    // together, with a scalar fallback.
+    class BlipBuffer
+    {
+    public:
+        // Kernel length, sub-sample resolution and cutoff, from cheapest to cleanest
+        enum class Quality
+        {
+            LOW,
+            MEDIUM,
+            HIGH
+        };
+
+        // Longest kernel of the presets, in samples
+        static constexpr int MAX_KERNEL_WIDTH = 32;
+
+        // Samples of the impulse sum to 1 << KERNEL_BITS
+        static constexpr int KERNEL_BITS = 13;
+
+        // Time is kept in 32.32 fixed point sample units
+        static constexpr int TIME_BITS = 32;
+
+        // Output frames that can be pending before a read
+        BlipBuffer(const size_t &capacity, const Quality &quality = Quality::MEDIUM);
+
+        void setRates(const double &clockRate, const double &sampleRate);
+
+        // Impulses already in the buffer are kept, changes from now on use the new kernel
+        void setQuality(const Quality &quality);
+        Quality getQuality();
+
+        // Clock cycles worth the whole capacity at the current rates
+        uint64_t maxClocks();
+
+        void clear();
+
+        // Amplitude changes of both sides at a clock time relative to the end of the last frame.
+        // They must fit in 16 bits.
+        void addDelta(const uint32_t &time, const int32_t &left, const int32_t &right);
+
+        // Close a frame of this many clocks, its samples become readable
+        void endFrame(const uint32_t &time);
+
+        size_t samplesAvailable();
+
+        // Read up to count interleaved stereo frames, returns the frames read
+        size_t readSamples(int16_t *out, const size_t &count);
+
+        // "low", "medium" or "high", false for anything else
+        static bool parseQuality(const std::string &name, Quality &quality);
+
+        // Vector instructions the buffer was built with
+        static const char *instructionSet();
+
+    private:
+        // Interleaved left and right sums
+        std::vector<int32_t> _buffer;
+        size_t _capacity;
+
+        Quality _quality;
+        int _kernelWidth;
+        int _phaseBits;
+
+        // Every phase of the kernel, each tap twice for the left and right lanes
+        std::vector<int16_t> _kernel;
+
+        // Samples per clock, and the position of the frame start, both in fixed point
+        uint64_t _factor;
+        uint64_t _offset;
+
+        // Running sums of the impulses read so far, high-passed to remove DC
+        int32_t _integrator[2];
+    };
+}
+
+#endif
@@ -1,4 +1,3 @@
-#include "utilitiesProvider.h"
 #include "gbException.h"
 #include "cartridge.h"
 #include "logger.h"
@@ -6,6 +5,7 @@
 #include "defs.h"
 #include "mbc.h"
 #include <iostream>
+#include <sstream>
 #include <cstdint>
 #include <bitset>
 #include <cmath>
@@ -17,12 +17,25 @@ namespace gasyboy
 
 	Cartridge &Cartridge::operator=(const Cartridge &other)
 	{
-		setMBC(other._mbc->getRom(), other._cartridgeType == CartridgeType::ROM_ONLY ? std::vector<uint8_t>() : other._mbc->getRam());
+		_rom = other._rom;
+		_romHash = other._romHash;
+		setMBC(other._rom, other._cartridgeType == CartridgeType::ROM_ONLY ? std::vector<uint8_t>() : other._mbc->getRam());
 		_cartridgeType = other._cartridgeType;
 		_cartridgeHeader = other._cartridgeHeader;
+		_romFilePath = other._romFilePath;
 		return *this;
 	}
 
+	void Cartridge::shareRom(const Cartridge &other)
+	{
+		_rom = other._rom;
+		_romHash = other._romHash;
+		setMBC(other._rom, std::vector<uint8_t>(other._cartridgeType == CartridgeType::ROM_ONLY ? 0 : other._mbc->getRam().size(), 0));
+		_cartridgeHeader = other._cartridgeHeader;
+		_ramBankCount = other._ramBankCount;
+		_romFilePath = other._romFilePath;
+	}
+
 	void Cartridge::loadRom(const std::string &filename)
 	{
 		std::ifstream file(filename, std::ios::binary | std::ios::ate);
@@ -34,17 +47,15 @@ namespace gasyboy
 		std::streamsize size = file.tellg();
 		file.seekg(0, std::ios::beg);
 
-		uint8_t *buffer = new uint8_t[size];
+		// Setting up ROM
+		auto rom = std::make_shared<std::vector<uint8_t>>(size);
 
-		if (!file.read(reinterpret_cast<char *>(buffer), size))
+		if (!file.read(reinterpret_cast<char *>(rom->data()), size))
 		{
 			throw std::runtime_error("Failed to read ROM file.");
 		}
 
-		// Setting up ROM
-		auto rom = std::vector<uint8_t>(buffer, buffer + size);
-
-		auto ramBankOffset = rom[0x149];
+		auto ramBankOffset = (*rom)[0x149];
 
 		// Setting up RAM
 		auto ram = std::vector<uint8_t>(getRamBanksCount(ramBankOffset) * 0x2000, 0);
@@ -57,14 +68,36 @@ namespace gasyboy
 
 		// Log cartridge informations
 		logCartridgeHeaderInfos();
+
+		_romFilePath = filename;
+	}
+
+	const std::string &Cartridge::getRomFilePath()
+	{
+		return _romFilePath;
+	}
+
+	uint64_t Cartridge::getRomHash()
+	{
+		return _romHash;
+	}
+
+	void Cartridge::saveState(StateWriter &writer)
+	{
+		_mbc->saveState(writer);
+	}
+
+	void Cartridge::loadState(StateReader &reader)
+	{
+		_mbc->loadState(reader);
 	}
 
 	void Cartridge::loadRomFromByteArray(const size_t &size, uint8_t *mem)
 	{
 		// Setting up ROM
-		auto rom = std::vector<uint8_t>(mem, mem + size);
+		auto rom = std::make_shared<std::vector<uint8_t>>(mem, mem + size);
 
-		auto ramBankOffset = rom[0x149];
+		auto ramBankOffset = (*rom)[0x149];
 
 		// Setting up RAM
 		auto ram = std::vector<uint8_t>(getRamBanksCount(ramBankOffset) * 0x2000, 0);
@@ -77,17 +110,26 @@ namespace gasyboy
 
 		// Log cartridge informations
 		logCartridgeHeaderInfos();
+
+		_romFilePath.clear();
 	}
 
-	void Cartridge::setMBC(const std::vector<uint8_t> &rom, const std::vector<uint8_t> &ram)
+	void Cartridge::setMBC(const SharedRom &rom, const std::vector<uint8_t> &ram)
 	{
-		_cartridgeType = utils::uint8ToCartridgeType(rom[0x147]);
+		_cartridgeType = utils::uint8ToCartridgeType((*rom)[0x147]);
+
+		// A shared ROM keeps its hash
+		if (rom != _rom)
+		{
+			_rom = rom;
+			_romHash = utils::hash64(rom->data(), rom->size());
+		}
 
-		int ramBanksCount = getRamBanksCount(rom[0x149]);
+		int ramBanksCount = getRamBanksCount((*rom)[0x149]);
 
-		_romBankCount = rom.size() / 0x4000;
+		_romBankCount = rom->size() / 0x4000;
 
-		switch (rom[0x147])
+		switch ((*rom)[0x147])
 		{
 		case 0x00:
 		case 0x08:
@@ -120,7 +162,7 @@ namespace gasyboy
 			break;
 		default:
 			std::stringstream ss;
-			ss << "\nIncorrect MBC type: " << std::hex << (int)rom[0x14] << "\n";
+			ss << "\nIncorrect MBC type: " << std::hex << (int)(*rom)[0x14] << "\n";
 			throw exception::GbException(ss.str());
 		}
 	}
@@ -130,7 +172,7 @@ namespace gasyboy
 		return _mbc->readByte(addr);
 	}
 
-	std::vector<uint8_t> &Cartridge::getRom()
+	const std::vector<uint8_t> &Cartridge::getRom()
 	{
 		return _mbc->getRom();
 	}
@@ -150,6 +192,11 @@ namespace gasyboy
 		return _mbc->readByte(addr);
 	}
 
+	int Cartridge::getRomBank(const uint16_t &addr)
+	{
+		return _mbc->getRomBank(addr);
+	}
+
 	void Cartridge::mbcRamWrite(const uint16_t &addr, const uint8_t &value)
 	{
 		_mbc->writeByte(addr, value);
@@ -269,6 +316,9 @@ namespace gasyboy
 		_cartridgeType = CartridgeType::ROM_ONLY;
 		_cartridgeHeader = CartridgeHeader();
 		_mbc.reset();
+		_rom.reset();
+		_romFilePath.clear();
+		_romHash = 0;
 	}
 
 	void Cartridge::getCartridgeHeaderInfos()
@@ -322,35 +372,38 @@ namespace gasyboy
 
 	void Cartridge::logCartridgeHeaderInfos()
 	{
-		std::stringstream cartridgeHeaderInfo;
-
-		cartridgeHeaderInfo << "ROM Name:        	 " << _cartridgeHeader.name
-							<< std::endl;
-		cartridgeHeaderInfo << "Manufacturer:    	 "
-							<< (_cartridgeHeader.manufacturer.empty()
-									? "N/A"
-									: _cartridgeHeader.manufacturer)
-							<< std::endl;
-		cartridgeHeaderInfo << "CGB Support:      	 "
-							<< _cartridgeHeader.cgbSupport << std::endl;
-		cartridgeHeaderInfo << "SGB Support:      	 "
-							<< (_cartridgeHeader.sgbSupport ? "Yes" : "No")
-							<< std::endl;
-		cartridgeHeaderInfo << "Cartridge Type:  	 "
-							<< _cartridgeHeader.cartridgeType << std::endl;
-		cartridgeHeaderInfo << "Rom Size:        	 " << _cartridgeHeader.romSize
-							<< std::endl;
-		cartridgeHeaderInfo << "RAM Size:        	 " << _cartridgeHeader.ramSize
-							<< std::endl;
-		cartridgeHeaderInfo << "Japanese Cartridge:  "
-							<< (_cartridgeHeader.isJapaneseCartridge ? "No" : "Yes")
-							<< std::endl;
-		cartridgeHeaderInfo << "Mask Rom Version:    " << std::hex
-							<< static_cast<int>(_cartridgeHeader.maskRomVersion)
-							<< std::endl;
-
-		utils::Logger::getInstance()->log(utils::Logger::LogType::DEBUG,
-										  "\n" + cartridgeHeaderInfo.str());
+		// The header text is only built for builds that keep DEBUG logs
+		if constexpr (utils::Logger::enabled(utils::Logger::LogType::DEBUG))
+		{
+			std::stringstream cartridgeHeaderInfo;
+
+			cartridgeHeaderInfo << "ROM Name:        	 " << _cartridgeHeader.name
+								<< std::endl;
+			cartridgeHeaderInfo << "Manufacturer:    	 "
+								<< (_cartridgeHeader.manufacturer.empty()
+										? "N/A"
+										: _cartridgeHeader.manufacturer)
+								<< std::endl;
+			cartridgeHeaderInfo << "CGB Support:      	 "
+								<< _cartridgeHeader.cgbSupport << std::endl;
+			cartridgeHeaderInfo << "SGB Support:      	 "
+								<< (_cartridgeHeader.sgbSupport ? "Yes" : "No")
+								<< std::endl;
+			cartridgeHeaderInfo << "Cartridge Type:  	 "
+								<< _cartridgeHeader.cartridgeType << std::endl;
+			cartridgeHeaderInfo << "Rom Size:        	 " << _cartridgeHeader.romSize
+								<< std::endl;
+			cartridgeHeaderInfo << "RAM Size:        	 " << _cartridgeHeader.ramSize
+								<< std::endl;
+			cartridgeHeaderInfo << "Japanese Cartridge:  "
+								<< (_cartridgeHeader.isJapaneseCartridge ? "No" : "Yes")
+								<< std::endl;
+			cartridgeHeaderInfo << "Mask Rom Version:    " << std::hex
+								<< static_cast<int>(_cartridgeHeader.maskRomVersion)
+								<< std::endl;
+
+			utils::Logger::getInstance()->log<utils::Logger::LogType::DEBUG>("\n", cartridgeHeaderInfo.str());
+		}
 	}
 
 	int Cartridge::getRamBanksCount(const uint8_t &value)
@@ -388,13 +441,12 @@ namespace gasyboy
 			return;
 		}
 
-		auto fileName = provider::UtilitiesProvider::getInstance()->romFilePath;
+		auto fileName = _romFilePath;
 		fileName = fileName.substr(0, fileName.find("."));
 		std::ofstream file(fileName + ".sav", std::ios::binary);
 		if (!file.is_open())
 		{
-			utils::Logger::getInstance()->log(utils::Logger::LogType::DEBUG,
-											  "Unable save RAM to file.");
+			utils::Logger::getInstance()->log<utils::Logger::LogType::DEBUG>("Unable save RAM to file.");
 			return;
 		}
 		file.write(reinterpret_cast<char *>(_mbc->getRam().data()), _mbc->getRam().size());
@@ -407,13 +459,12 @@ namespace gasyboy
 			return;
 		}
 
-		auto fileName = provider::UtilitiesProvider::getInstance()->romFilePath;
+		auto fileName = _romFilePath;
 		fileName = fileName.substr(0, fileName.find("."));
 		std::ifstream file(fileName + ".sav", std::ios::binary | std::ios::ate);
 		if (!file.is_open())
 		{
-			utils::Logger::getInstance()->log(utils::Logger::LogType::DEBUG,
-											  "Unable to open RAM file.");
+			utils::Logger::getInstance()->log<utils::Logger::LogType::DEBUG>("Unable to open RAM file.");
 			return;
 		}
 		auto size = file.tellg();
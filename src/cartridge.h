@@ -18,6 +18,15 @@ namespace gasyboy
         // MBC
         std::unique_ptr<IMBC> _mbc;
 
+        // ROM contents, shared with forked instances
+        SharedRom _rom;
+
+        // File the ROM was loaded from, the save file sits next to it
+        std::string _romFilePath;
+
+        // Identifies the ROM a save state belongs to
+        uint64_t _romHash = 0;
+
     public:
         // Constructor/destructor
         Cartridge();
@@ -299,11 +308,20 @@ namespace gasyboy
         // For debugging
         void loadRomFromByteArray(const size_t &size, uint8_t *mem);
 
+        // Path of the loaded ROM file, empty when loaded from memory
+        const std::string &getRomFilePath();
+
+        // Hash of the loaded ROM
+        uint64_t getRomHash();
+
+        // Use the ROM of another cartridge without copying it, with blank RAM and no logging
+        void shareRom(const Cartridge &other);
+
         // Set MBC type
-        void setMBC(const std::vector<uint8_t> &rom, const std::vector<uint8_t> &ram);
+        void setMBC(const SharedRom &rom, const std::vector<uint8_t> &ram);
 
         // Get ROM
-        std::vector<uint8_t> &getRom();
+        const std::vector<uint8_t> &getRom();
 
         // Get RAM
         std::vector<uint8_t> &getRam();
@@ -312,6 +330,9 @@ namespace gasyboy
         uint8_t mbcRomRead(const uint16_t &adrr);
         uint8_t mbcRamRead(const uint16_t &adrr);
 
+        // ROM bank mapped at an address below 0x8000
+        int getRomBank(const uint16_t &adrr);
+
         // ROM/RAM writing from MBC
         void mbcRomWrite(const uint16_t &adrr, const uint8_t &value);
         void mbcRamWrite(const uint16_t &adrr, const uint8_t &value);
@@ -342,6 +363,10 @@ namespace gasyboy
 
         // Load RAM from file
         void loadRam();
+
+        // Save state
+        void saveState(StateWriter &writer);
+        void loadState(StateReader &reader);
     };
 
     struct RtcState
@@ -4,7 +4,10 @@
 #include "interruptManager.h"
 #include "registers.h"
 #include "register.h"
+#include "timer.h"
+#include "utilities.h"
 #include "mmu.h"
+#include "executionStats.h"
 #include <memory>
 
 // Class of the gameboy CPU (nearly the same as the z80)
@@ -15,13 +18,19 @@ namespace gasyboy
 	{
 	private:
 		// Registers
-		std::shared_ptr<Registers> _registers;
+		Registers &_registers;
 
 		// MMU
-		std::shared_ptr<Mmu> _mmu;
+		Mmu &_mmu;
 
 		// Interrupt Manager
-		std::shared_ptr<InterruptManager> _interruptManager;
+		InterruptManager &_interruptManager;
+
+		// Timer, DIV is reset by STOP
+		Timer &_timer;
+
+		// Emulator settings
+		Utilities &_utilities;
 
 		// The current opcode pointed by the PC
 		uint8_t _currentOpcode;
@@ -35,15 +44,22 @@ namespace gasyboy
 
 		bool _pcManuallySet = false;
 
+		// Instruction counters, null unless enabled
+		std::unique_ptr<ExecutionStats> _executionStats;
+
 	public:
 		// Contructor/destructor
-		Cpu();
+		Cpu(Mmu &mmu, Registers &registers, InterruptManager &interruptManager, Timer &timer, Utilities &utilities);
 		Cpu &operator=(const Cpu &);
 		~Cpu() = default;
 
 		// Reset the cpu
 		void reset();
 
+		// Save state
+		void saveState(StateWriter &writer);
+		void loadState(StateReader &reader);
+
 		// A step of the cpu
 		long step();
 
@@ -57,6 +73,10 @@ namespace gasyboy
 		// Fetch the current opcode
 		void fetch();
 
+		// Instruction counters, null when disabled. Enabling them starts from zero.
+		ExecutionStats *getExecutionStats();
+		void setExecutionStats(const bool &enabled);
+
 		enum class State
 		{
 			PAUSED,
@@ -64,7 +84,7 @@ namespace gasyboy
 			STOPPED,
 			STEPPING
 		};
-		static State state;
+		State state;
 
 		// Getters
 		uint16_t getRegister(const Register::RegisterPairName &reg);
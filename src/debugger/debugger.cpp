@@ -3,37 +3,43 @@
 #include "gameboy.h"
 #include "gamepad.h"
 #include "logger.h"
+#include "profiler.h"
 #include "mmu.h"
 #include <chrono>
+#include <iomanip>
 
-#include "interruptManagerProvider.h"
-#include "registersProvider.h"
-#include "utilitiesProvider.h"
-#include "gamepadProvider.h"
-#include "gameBoyProvider.h"
-#include "timerProvider.h"
-#include "mmuProvider.h"
-#include "cpuProvider.h"
-#include "ppuProvider.h"
+#include "gameboy.h"
 
 namespace gasyboy
 {
+    namespace
+    {
+        std::string hexLabel(const size_t &value, const int &digits)
+        {
+            std::stringstream ss;
+            ss << std::uppercase << std::hex << std::setw(digits) << std::setfill('0') << value;
+            return ss.str();
+        }
+    }
 
-    Debugger::Debugger(SDL_Window *mainWindow)
-        : _mmu(provider::MmuProvider::getInstance()),
-          _registers(provider::RegistersProvider::getInstance()),
-          _ppu(provider::PpuProvider::getInstance()),
+    Debugger::Debugger(SDL_Window *mainWindow, GameBoy &gameboy)
+        : _gameboy(gameboy),
+          _mmu(gameboy.getMmu()),
+          _registers(gameboy.getRegisters()),
+          _ppu(gameboy.getPpu()),
+          _cpu(gameboy.getCpu()),
+          _gamepad(gameboy.getGamepad()),
           _window(nullptr),
           _renderer(nullptr),
           _breakPoints(),
           _currentBreakPoint(-1),
-          _timer(provider::TimerProvider::getInstance()),
+          _timer(gameboy.getTimer()),
           _currentSelectedRomBank(1),
           _lcdEnable(false),
           _previewPos(ImVec2(845, 165)),
           _previewSprite(),
-          _disassembler(),
-          _executeBios(provider::UtilitiesProvider::getInstance()->executeBios)
+          _disassembler(gameboy.getMmu().getCartridge()),
+          _executeBios(gameboy.getUtilities().executeBios)
     {
         _bytesBuffers = {
             {"A", ""},
@@ -155,11 +161,6 @@ namespace gasyboy
         for (auto &direction : _directions)
             direction.second = false;
 
-        // Reset submodules
-        _mmu = provider::MmuProvider::getInstance();
-        _ppu = provider::PpuProvider::getInstance();
-        _registers = provider::RegistersProvider::getInstance();
-
         _bytesBuffers = {
             {"A", ""},
             {"F", ""},
@@ -218,6 +219,8 @@ namespace gasyboy
 
     void Debugger::render()
     {
+        GASYBOY_PROFILE_SCOPE("Debugger::render");
+
         // Start ImGui frame
         ImGui_ImplSDL2_NewFrame();
         ImGui_ImplSDLRenderer2_NewFrame();
@@ -241,6 +244,9 @@ namespace gasyboy
         // Rendering Disassembler
         // renderDisassemblerScreen();
 
+        // Rendering execution counters, in the disassembler's place
+        renderExecutionStatsScreen();
+
         ImGui::Render();
         SDL_RenderClear(_renderer);
         ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData(), _renderer);
@@ -294,52 +300,52 @@ namespace gasyboy
 
             ImGui::TableNextColumn();
             renderByte("A", [&]()
-                       { return _registers->AF.getLeftRegister(); }, [&](const uint8_t &val)
-                       { _registers->AF.setLeftRegister(val); });
+                       { return _registers.AF.getLeftRegister(); }, [&](const uint8_t &val)
+                       { _registers.AF.setLeftRegister(val); });
             ImGui::SameLine();
             renderByte("F", [&]()
-                       { return _registers->AF.getRightRegister(); }, [&](const uint8_t &val)
-                       { _registers->AF.setRightRegister(val); });
+                       { return _registers.AF.getRightRegister(); }, [&](const uint8_t &val)
+                       { _registers.AF.setRightRegister(val); });
 
             renderByte("B", [&]()
-                       { return _registers->BC.getLeftRegister(); }, [&](const uint8_t &val)
-                       { _registers->BC.setLeftRegister(val); });
+                       { return _registers.BC.getLeftRegister(); }, [&](const uint8_t &val)
+                       { _registers.BC.setLeftRegister(val); });
             ImGui::SameLine();
             renderByte("C", [&]()
-                       { return _registers->BC.getRightRegister(); }, [&](const uint8_t &val)
-                       { _registers->BC.setRightRegister(val); });
+                       { return _registers.BC.getRightRegister(); }, [&](const uint8_t &val)
+                       { _registers.BC.setRightRegister(val); });
 
             renderByte("D", [&]()
-                       { return _registers->DE.getLeftRegister(); }, [&](const uint8_t &val)
-                       { _registers->DE.setLeftRegister(val); });
+                       { return _registers.DE.getLeftRegister(); }, [&](const uint8_t &val)
+                       { _registers.DE.setLeftRegister(val); });
             ImGui::SameLine();
             renderByte("E", [&]()
-                       { return _registers->DE.getRightRegister(); }, [&](const uint8_t &val)
-                       { _registers->DE.setRightRegister(val); });
+                       { return _registers.DE.getRightRegister(); }, [&](const uint8_t &val)
+                       { _registers.DE.setRightRegister(val); });
 
             renderByte("H", [&]()
-                       { return _registers->HL.getLeftRegister(); }, [&](const uint8_t &val)
-                       { _registers->HL.setLeftRegister(val); });
+                       { return _registers.HL.getLeftRegister(); }, [&](const uint8_t &val)
+                       { _registers.HL.setLeftRegister(val); });
             ImGui::SameLine();
             renderByte("L", [&]()
-                       { return _registers->HL.getRightRegister(); }, [&](const uint8_t &val)
-                       { _registers->HL.setRightRegister(val); });
+                       { return _registers.HL.getRightRegister(); }, [&](const uint8_t &val)
+                       { _registers.HL.setRightRegister(val); });
 
             renderWord("SP", [&]()
-                       { return _registers->SP; }, [&](uint16_t val)
-                       { _registers->SP = val; });
+                       { return _registers.SP; }, [&](uint16_t val)
+                       { _registers.SP = val; });
 
             renderWord("PC", [&]()
-                       { return _registers->PC; }, [&](uint16_t val)
-                       { _registers->PC = val; });
+                       { return _registers.PC; }, [&](uint16_t val)
+                       { _registers.PC = val; });
 
             ImGui::TableNextColumn();
 
             ImGui::Text("Flags");
-            bool Z = _registers->AF.getFlag(Register::FlagName::Z);
-            bool N = _registers->AF.getFlag(Register::FlagName::N);
-            bool H = _registers->AF.getFlag(Register::FlagName::H);
-            bool C = _registers->AF.getFlag(Register::FlagName::C);
+            bool Z = _registers.AF.getFlag(Register::FlagName::Z);
+            bool N = _registers.AF.getFlag(Register::FlagName::N);
+            bool H = _registers.AF.getFlag(Register::FlagName::H);
+            bool C = _registers.AF.getFlag(Register::FlagName::C);
             ImGui::Checkbox("Zero", &Z);
             ImGui::Checkbox("Subtract", &N);
             ImGui::Checkbox("Half Carry", &H);
@@ -347,13 +353,13 @@ namespace gasyboy
 
             ImGui::Separator();
             ImGui::Text("State");
-            bool halted = _registers->getHalted();
+            bool halted = _registers.getHalted();
             ImGui::Checkbox("HALTED", &halted);
-            _registers->setHalted(halted);
+            _registers.setHalted(halted);
             ImGui::SameLine();
-            bool stopped = _registers->getStopMode();
+            bool stopped = _registers.getStopMode();
             ImGui::Checkbox("STOPPED", &stopped);
-            _registers->setStopMode(stopped);
+            _registers.setStopMode(stopped);
 
             ImGui::EndTable();
         }
@@ -363,27 +369,27 @@ namespace gasyboy
         if (ImGui::Button("Pause", ImVec2(75, 0)))
         {
             std::cout << "Pause pressed!\n";
-            Cpu::state = Cpu::State::PAUSED;
+            _cpu.state = Cpu::State::PAUSED;
         }
 
         ImGui::SameLine();
         if (ImGui::Button("Run", ImVec2(75, 0)))
         {
             std::cout << "Resume pressed!\n";
-            Cpu::state = Cpu::State::RUNNING;
+            _cpu.state = Cpu::State::RUNNING;
         }
 
         ImGui::SameLine();
         if (ImGui::Button("Step", ImVec2(75, 0)))
         {
             std::cout << "Step pressed!\n";
-            Cpu::state = Cpu::State::STEPPING;
+            _cpu.state = Cpu::State::STEPPING;
         }
 
         ImGui::SameLine();
         if (ImGui::Button("Open"))
         {
-            Cpu::state = Cpu::State::PAUSED;
+            _cpu.state = Cpu::State::PAUSED;
 
             IGFD::FileDialogConfig config;
             config.path = ".";
@@ -403,9 +409,9 @@ namespace gasyboy
             {
                 std::string filePath = ImGuiFileDialog::Instance()->GetFilePathName(); // Get selected file
 
-                provider::UtilitiesProvider::getInstance()->romFilePath = filePath;
-                provider::UtilitiesProvider::getInstance()->newRomFilePath = filePath;
-                provider::GameBoyProvider::getInstance()->reset();
+                _gameboy.getUtilities().romFilePath = filePath;
+                _gameboy.getUtilities().newRomFilePath = filePath;
+                _gameboy.reset();
             }
 
             // Close the dialog to prevent reopening
@@ -432,24 +438,24 @@ namespace gasyboy
             ImGui::TableNextColumn();
 
             renderByte("DIV", [&]()
-                       { return _timer->DIV(); }, [&](const uint8_t &value)
-                       { _timer->setDIV(value); });
+                       { return _timer.DIV(); }, [&](const uint8_t &value)
+                       { _timer.setDIV(value); });
 
             renderByte("TIMA", [&]()
-                       { return _timer->TIMA(); }, [&](const uint8_t &value)
-                       { _timer->setTIMA(value); });
+                       { return _timer.TIMA(); }, [&](const uint8_t &value)
+                       { _timer.setTIMA(value); });
             ImGui::SameLine();
-            renderWord("TIMA_INCREMENT_RATE", [&]()
-                       { return _timer->_timaIncrementRate; }, [&](const uint16_t &value)
-                       { _timer->_timaIncrementRate = value; }, 10);
+            renderWord("SYSTEM_COUNTER", [&]()
+                       { return _timer.systemCounter(); }, [&](const uint16_t &value)
+                       { _timer.setSystemCounter(value); });
 
             renderByte("TMA", [&]()
-                       { return _timer->TMA(); }, [&](const uint8_t &value)
-                       { _timer->setTMA(value); });
+                       { return _timer.TMA(); }, [&](const uint8_t &value)
+                       { _timer.setTMA(value); });
 
             renderByte("TAC", [&]()
-                       { return _timer->TAC(); }, [&](const uint8_t &value)
-                       { _timer->setTAC(value); });
+                       { return _timer.TAC(); }, [&](const uint8_t &value)
+                       { _timer.setTAC(value); });
 
             ImGui::EndTable();
         }
@@ -466,11 +472,11 @@ namespace gasyboy
         // Create the window
         ImGui::Begin("Joypad", nullptr, ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoCollapse);
 
-        if (!Gamepad::isButtonSelected())
+        if (!_gamepad.isButtonSelected())
         {
             for (size_t i = 0; i < 4; i++)
             {
-                _directions[i].second = !(_mmu->readRam(0xFF00) & (1 << i));
+                _directions[i].second = !(_mmu.readRam(0xFF00) & (1 << i));
                 _buttons[i].second = false;
             }
         }
@@ -479,7 +485,7 @@ namespace gasyboy
             for (size_t i = 0; i < 4; i++)
             {
                 _directions[i].second = false;
-                _buttons[i].second = !(_mmu->readRam(0xFF00) & (1 << i));
+                _buttons[i].second = !(_mmu.readRam(0xFF00) & (1 << i));
             }
         }
 
@@ -531,7 +537,7 @@ namespace gasyboy
             if (ImGui::BeginTabItem("ROM0"))
             {
                 ImGui::Text("ROM [0x0 - 0x4000]");
-                auto rom = std::span<uint8_t>(_mmu->getCartridge().getRom().begin(), 0x4000);
+                auto rom = std::span<const uint8_t>(_mmu.getCartridge().getRom().begin(), 0x4000);
                 showByteArray(rom);
                 ImGui::EndTabItem();
             }
@@ -542,8 +548,8 @@ namespace gasyboy
                 ImGui::Text("ROM [0x4000 - 0x8000] (multiple banks)");
                 ImGui::SameLine();
                 ImGui::SetNextItemWidth(75);
-                showIntegerCombo(1, _mmu->getCartridge()._romBankCount - 1, _currentSelectedRomBank);
-                auto rom = std::span<uint8_t>(_mmu->getCartridge().getRom().begin() + _currentSelectedRomBank * 0x4000, 0x4000);
+                showIntegerCombo(1, _mmu.getCartridge()._romBankCount - 1, _currentSelectedRomBank);
+                auto rom = std::span<const uint8_t>(_mmu.getCartridge().getRom().begin() + _currentSelectedRomBank * 0x4000, 0x4000);
                 showByteArray(rom, 0x4000);
                 ImGui::EndTabItem();
             }
@@ -551,14 +557,14 @@ namespace gasyboy
             // Ext RAM
             if (ImGui::BeginTabItem("SRAM"))
             {
-                auto ramBankCount = _mmu->getCartridge()._ramBankCount;
+                auto ramBankCount = _mmu.getCartridge()._ramBankCount;
                 if (ramBankCount == 0)
                 {
                     ImGui::Text("No SRAM");
                 }
                 else
                 {
-                    auto &ram = _mmu->getCartridge().getRam();
+                    auto &ram = _mmu.getCartridge().getRam();
                     ImGui::Text("SRAM");
                     ImGui::SetNextItemWidth(75);
                     showIntegerCombo(0, ramBankCount - 1, _currentSelectedRamBank);
@@ -571,7 +577,7 @@ namespace gasyboy
             if (ImGui::BeginTabItem("VRAM"))
             {
                 ImGui::Text("VRAM");
-                auto vram = std::span<uint8_t>(_mmu->getMemory().begin() + 0x8000, 0x2000);
+                auto vram = std::span<uint8_t>(_mmu.getMemory().begin() + 0x8000, 0x2000);
                 showByteArray(vram, 0x8000);
                 ImGui::EndTabItem();
             }
@@ -580,7 +586,7 @@ namespace gasyboy
             if (ImGui::BeginTabItem("OAM"))
             {
                 ImGui::Text("OAM");
-                auto vram = std::span<uint8_t>(_mmu->getMemory().begin() + 0xFE00, 0xA0);
+                auto vram = std::span<uint8_t>(_mmu.getMemory().begin() + 0xFE00, 0xA0);
                 showByteArray(vram, 0xFE00);
                 ImGui::EndTabItem();
             }
@@ -637,7 +643,7 @@ namespace gasyboy
             {
                 int tileX = _previewSprite.options.xFlip ? (7 - px) : px;
                 int tileY = _previewSprite.options.yFlip ? (7 - py) : py;
-                uint8_t pixelValue = _mmu->tiles[_previewSprite.tile].pixels[tileY][tileX];
+                uint8_t pixelValue = _mmu.tiles[_previewSprite.tile].pixels[tileY][tileX];
                 ImU32 color = PixelToColor(pixelValue);
                 previewDrawList->AddRectFilled(
                     ImVec2(_previewPos.x + px * (pixelSize * 4), _previewPos.y + py * (pixelSize * 4)),
@@ -658,8 +664,8 @@ namespace gasyboy
         // Create the window
         ImGui::Begin("Disassembler", nullptr, ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoCollapse);
 
-        uint16_t targetAddress = _registers->PC; // Assume we want to scroll to the current PC
-        static uint16_t previousPC = _registers->PC;
+        uint16_t targetAddress = _registers.PC; // Assume we want to scroll to the current PC
+        static uint16_t previousPC = _registers.PC;
         int targetIndex = -1;     // Will store the index of the target address
         int surroundingLines = 5; // Number of lines before/after to show for lazy loading
 
@@ -707,7 +713,7 @@ namespace gasyboy
             // Pause if any break point hit
             if (_currentBreakPoint < 0 && std::find(_breakPoints.begin(), _breakPoints.end(), targetAddress) != _breakPoints.end())
             {
-                Cpu::state = Cpu::State::PAUSED;
+                _cpu.state = Cpu::State::PAUSED;
                 auto it = std::find(_breakPoints.begin(), _breakPoints.end(), targetAddress);
                 _breakPoints.erase(it);
                 _currentBreakPoint = targetAddress;
@@ -800,7 +806,7 @@ namespace gasyboy
         if (!sprite.ready)
             return; // Skip rendering if sprite is not ready
 
-        const Mmu::Tile &tile = _mmu->tiles[sprite.tile]; // Get the tile corresponding to the sprite
+        const Mmu::Tile &tile = _mmu.tiles[sprite.tile]; // Get the tile corresponding to the sprite
 
         // ImGui::GetWindowDrawList() returns the current drawing list to draw custom elements
         ImDrawList *drawList = ImGui::GetWindowDrawList();
@@ -858,11 +864,11 @@ namespace gasyboy
             {
                 ImGui::Text("Control Register");
 
-                _lcdEnable = _ppu->LCDC->lcdEnable == 1;
+                _lcdEnable = _ppu.LCDC->lcdEnable == 1;
                 ImGui::Checkbox("LCD Enable", &_lcdEnable);
-                if (_lcdEnable != _ppu->LCDC->lcdEnable)
+                if (_lcdEnable != _ppu.LCDC->lcdEnable)
                 {
-                    _ppu->LCDC->lcdEnable = _lcdEnable;
+                    _ppu.LCDC->lcdEnable = _lcdEnable;
                 }
 
                 ImGui::Text("WINDOW_TILE_MAP_AREA");
@@ -873,14 +879,14 @@ namespace gasyboy
                 if (ImGui::Combo("##WINDOW_TILE_MAP_AREA", &windowDisplaySelectValue, windowDisplaySelectValues, IM_ARRAYSIZE(windowDisplaySelectValues)))
                 {
                     printf("Selected: %s\n", windowDisplaySelectValues[windowDisplaySelectValue]);
-                    _ppu->LCDC->windowDisplaySelect = (windowDisplaySelectValue == 0) ? 0 : 1;
+                    _ppu.LCDC->windowDisplaySelect = (windowDisplaySelectValue == 0) ? 0 : 1;
                 }
 
-                _windowEnable = _ppu->LCDC->windowEnable == 1;
+                _windowEnable = _ppu.LCDC->windowEnable == 1;
                 ImGui::Checkbox("Window Enable", &_windowEnable);
-                if (_windowEnable != _ppu->LCDC->windowEnable)
+                if (_windowEnable != _ppu.LCDC->windowEnable)
                 {
-                    _ppu->LCDC->windowEnable = _windowEnable;
+                    _ppu.LCDC->windowEnable = _windowEnable;
                 }
 
                 ImGui::Text("BG_WINDOW_TILE_DATA_MAP_AREA");
@@ -891,28 +897,28 @@ namespace gasyboy
                 if (ImGui::Combo("##BG_WINDOW_TILE_DATA_MAP_AREA", &bgDisplaySelectValue, bgDisplaySelectValues, IM_ARRAYSIZE(bgDisplaySelectValues)))
                 {
                     printf("Selected: %s\n", bgDisplaySelectValues[bgDisplaySelectValue]);
-                    _ppu->LCDC->bgDisplaySelect = (bgDisplaySelectValue == 0) ? 0 : 1;
+                    _ppu.LCDC->bgDisplaySelect = (bgDisplaySelectValue == 0) ? 0 : 1;
                 }
 
-                _objSize8x8 = _ppu->LCDC->spriteSize == 1;
+                _objSize8x8 = _ppu.LCDC->spriteSize == 1;
                 ImGui::Checkbox("OBJ Size 8x8", &_objSize8x8);
-                if (_objSize8x8 != _ppu->LCDC->spriteSize)
+                if (_objSize8x8 != _ppu.LCDC->spriteSize)
                 {
-                    _ppu->LCDC->spriteSize = _objSize8x8;
+                    _ppu.LCDC->spriteSize = _objSize8x8;
                 }
 
-                _objEnabled = _ppu->LCDC->spriteDisplayEnable == 1;
+                _objEnabled = _ppu.LCDC->spriteDisplayEnable == 1;
                 ImGui::Checkbox("OBJ Enabled", &_objEnabled);
-                if (_objEnabled != _ppu->LCDC->spriteDisplayEnable)
+                if (_objEnabled != _ppu.LCDC->spriteDisplayEnable)
                 {
-                    _ppu->LCDC->spriteDisplayEnable = _objEnabled;
+                    _ppu.LCDC->spriteDisplayEnable = _objEnabled;
                 }
 
-                _bgWindowEnablePriority = _ppu->LCDC->bgDisplay == 1;
+                _bgWindowEnablePriority = _ppu.LCDC->bgDisplay == 1;
                 ImGui::Checkbox("BG & Window Enable Priority", &_bgWindowEnablePriority);
-                if (_bgWindowEnablePriority != _ppu->LCDC->bgDisplay)
+                if (_bgWindowEnablePriority != _ppu.LCDC->bgDisplay)
                 {
-                    _ppu->LCDC->bgDisplay = _bgWindowEnablePriority;
+                    _ppu.LCDC->bgDisplay = _bgWindowEnablePriority;
                 }
 
                 ImGui::EndTabItem();
@@ -928,50 +934,50 @@ namespace gasyboy
 
                 if (!manual)
                 {
-                    _scy = _mmu->readRam(0xFF42);
-                    _scx = _mmu->readRam(0xFF43);
-                    _wy = _mmu->readRam(0xFF4A);
+                    _scy = _mmu.readRam(0xFF42);
+                    _scx = _mmu.readRam(0xFF43);
+                    _wy = _mmu.readRam(0xFF4A);
                     if (_wx > 144)
                         _wx = 144;
-                    _wx = _mmu->readRam(0xFF4B);
+                    _wx = _mmu.readRam(0xFF4B);
                     if (_wx > 166)
                         _wx = 166;
-                    _ly = _mmu->readRam(0xFF44);
-                    _lyc = _mmu->readRam(0xFF45);
+                    _ly = _mmu.readRam(0xFF44);
+                    _lyc = _mmu.readRam(0xFF45);
                 }
                 else
                 {
-                    if (_scy != _mmu->readRam(0xff42))
+                    if (_scy != _mmu.readRam(0xff42))
                     {
-                        _mmu->writeRam(0xFF42, _scy);
-                        _ppu->_debugRender = true;
+                        _mmu.writeRam(0xFF42, _scy);
+                        _ppu._debugRender = true;
                     }
-                    if (_scx != _mmu->readRam(0xff43))
+                    if (_scx != _mmu.readRam(0xff43))
                     {
-                        _mmu->writeRam(0xFF43, _scx);
-                        _ppu->_debugRender = true;
+                        _mmu.writeRam(0xFF43, _scx);
+                        _ppu._debugRender = true;
                     }
-                    if (_wy != _mmu->readRam(0xff4A))
+                    if (_wy != _mmu.readRam(0xff4A))
                     {
-                        _mmu->writeRam(0xFF4A, _wy);
-                        _ppu->_debugRender = true;
+                        _mmu.writeRam(0xFF4A, _wy);
+                        _ppu._debugRender = true;
                     }
-                    if (_wx != _mmu->readRam(0xff4B))
+                    if (_wx != _mmu.readRam(0xff4B))
                     {
-                        _mmu->writeRam(0xFF4B, _wx);
-                        _ppu->_debugRender = true;
+                        _mmu.writeRam(0xFF4B, _wx);
+                        _ppu._debugRender = true;
                     }
 
-                    if (_ly != _mmu->readRam(0xff44))
+                    if (_ly != _mmu.readRam(0xff44))
                     {
-                        _mmu->writeRam(0xFF44, _ly);
-                        _ppu->_debugRender = true;
+                        _mmu.writeRam(0xFF44, _ly);
+                        _ppu._debugRender = true;
                     }
 
-                    if (_lyc != _mmu->readRam(0xff45))
+                    if (_lyc != _mmu.readRam(0xff45))
                     {
-                        _mmu->writeRam(0xFF45, _lyc);
-                        _ppu->_debugRender = true;
+                        _mmu.writeRam(0xFF45, _lyc);
+                        _ppu._debugRender = true;
                     }
                 }
 
@@ -990,9 +996,9 @@ namespace gasyboy
             {
                 ImGui::Text("Palette");
 
-                showPalette("BGP", _mmu->palette_BGP);
-                showPalette("OBP0", _mmu->palette_OBP0);
-                showPalette("OBP1", _mmu->palette_OBP1);
+                showPalette("BGP", _mmu.palette_BGP);
+                showPalette("OBP0", _mmu.palette_OBP0);
+                showPalette("OBP1", _mmu.palette_OBP1);
 
                 ImGui::EndTabItem();
             }
@@ -1021,7 +1027,7 @@ namespace gasyboy
                     {
                         for (int x = 0; x < 8; ++x)
                         {
-                            uint8_t pixelValue = _mmu->tiles[tileIndex].pixels[y][x];
+                            uint8_t pixelValue = _mmu.tiles[tileIndex].pixels[y][x];
                             ImU32 color = PixelToColor(pixelValue); // Convert pixel value to color
 
                             // Draw a small square for each pixel
@@ -1047,7 +1053,7 @@ namespace gasyboy
                 int j = 0;
                 for (int i = 0; i < 40; ++i, j++)
                 {
-                    const Mmu::Sprite &sprite = _mmu->sprites[i];
+                    const Mmu::Sprite &sprite = _mmu.sprites[i];
 
                     // Only render if the sprite is ready
                     if (!sprite.ready)
@@ -1118,7 +1124,7 @@ namespace gasyboy
         clipper.End();
     }
 
-    void Debugger::showByteArray(std::span<uint8_t> &data, const uint16_t &offset, size_t bytes_per_row, const bool &writable)
+    void Debugger::showByteArray(std::span<const uint8_t> data, const uint16_t &offset, size_t bytes_per_row, const bool &writable)
     {
         // This variable holds the index of the byte currently being edited.
         static int editedByteIndex = -1;
@@ -1162,8 +1168,8 @@ namespace gasyboy
                         {
                             if (ImGui::InputScalar(label, ImGuiDataType_U8, &temp, nullptr, nullptr, "%02X", ImGuiInputTextFlags_CharsHexadecimal))
                             {
-                                data[byteIndex] = temp;
-                                _mmu->writeRam(byteIndex + offset, temp);
+                                // Written through the MMU, the span may be read-only
+                                _mmu.writeRam(byteIndex + offset, temp);
                             }
                             // When done editing, exit edit mode.
                             if (ImGui::IsItemDeactivatedAfterEdit())
@@ -1259,9 +1265,105 @@ namespace gasyboy
 
     ImU32 Debugger::PixelToColor(uint8_t pixelValue)
     {
-        const Colour &color = _mmu->palette_colours[pixelValue];
+        const Colour &color = _mmu.palette_colours[pixelValue];
 
         // Convert to ImGui color format (RGBA)
         return IM_COL32(color.r, color.g, color.b, color.a);
     }
-}
\ No newline at end of file
+
+    void Debugger::renderExecutionStatsScreen()
+    {
+        // Rows shown per table
+        constexpr size_t ROWS = 32;
+
+        ImGui::SetNextWindowPos(ImVec2(0, 365), ImGuiCond_Always);
+        ImGui::SetNextWindowSize(ImVec2(670, 400), ImGuiCond_Always);
+
+        ImGui::Begin("Execution Stats", nullptr, ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoCollapse);
+
+        bool enabled = _cpu.getExecutionStats() != nullptr;
+        if (ImGui::Checkbox("Count instructions", &enabled))
+        {
+            _cpu.setExecutionStats(enabled);
+        }
+
+        ExecutionStats *stats = _cpu.getExecutionStats();
+        if (!stats)
+        {
+            ImGui::End();
+            return;
+        }
+
+        ImGui::SameLine();
+        if (ImGui::Button("Reset"))
+        {
+            stats->clear();
+        }
+
+        const ExecutionStats::Counter total = stats->getTotal();
+        ImGui::SameLine();
+        ImGui::Text("Instructions: %llu, cycles: %llu", static_cast<unsigned long long>(total.count), static_cast<unsigned long long>(total.cycles));
+
+        if (ImGui::BeginTabBar("##ExecutionStatsTabs"))
+        {
+            if (ImGui::BeginTabItem("Opcodes"))
+            {
+                const auto &opcodes = stats->getOpcodes();
+                renderExecutionStatsTable("##Opcodes", ExecutionStats::sorted(opcodes.data(), opcodes.size(), ROWS), total.cycles, [](const size_t &index)
+                                          { return hexLabel(index, 2); });
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("CB Opcodes"))
+            {
+                const auto &opcodes = stats->getCbOpcodes();
+                renderExecutionStatsTable("##CbOpcodes", ExecutionStats::sorted(opcodes.data(), opcodes.size(), ROWS), total.cycles, [](const size_t &index)
+                                          { return "CB " + hexLabel(index, 2); });
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("ROM Banks"))
+            {
+                const auto &banks = stats->getBanks();
+                renderExecutionStatsTable("##Banks", ExecutionStats::sorted(banks.data(), banks.size(), ROWS), total.cycles, [](const size_t &index)
+                                          { return index == ExecutionStats::OUTSIDE_ROM ? std::string("BIOS/RAM") : std::to_string(index); });
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Addresses"))
+            {
+                const auto &pcs = stats->getPcs();
+                renderExecutionStatsTable("##Addresses", ExecutionStats::sorted(pcs.data(), pcs.size(), ROWS), total.cycles, [](const size_t &index)
+                                          { return hexLabel(index, 4); });
+                ImGui::EndTabItem();
+            }
+            ImGui::EndTabBar();
+        }
+
+        ImGui::End();
+    }
+
+    void Debugger::renderExecutionStatsTable(const char *id, const std::vector<ExecutionStats::Entry> &entries, const uint64_t &totalCycles,
+                                             const std::function<std::string(const size_t &)> &label)
+    {
+        if (ImGui::BeginTable(id, 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY))
+        {
+            ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Executions", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Cycles", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Cycles %", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableHeadersRow();
+
+            for (const auto &entry : entries)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(label(entry.index).c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", static_cast<unsigned long long>(entry.counter.count));
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", static_cast<unsigned long long>(entry.counter.cycles));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", totalCycles > 0 ? entry.counter.cycles * 100.0 / totalCycles : 0.0);
+            }
+            ImGui::EndTable();
+        }
+    }
+}
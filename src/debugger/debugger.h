@@ -5,6 +5,7 @@
 #include "backends/imgui_impl_sdlrenderer2.h"
 #include "SDL.h"
 #include "registers.h"
+#include "cpu.h"
 #include <chrono>
 #include "timer.h"
 #include <functional>
@@ -16,10 +17,12 @@
 
 namespace gasyboy
 {
+    class GameBoy;
+
     class Debugger
     {
     public:
-        Debugger(SDL_Window *mainWindow);
+        Debugger(SDL_Window *mainWindow, GameBoy &gameboy);
         ~Debugger();
 
         void render();
@@ -78,10 +81,14 @@ namespace gasyboy
 
     private:
         SDL_Renderer *_renderer;
-        std::shared_ptr<Registers> _registers;
-        std::shared_ptr<Mmu> _mmu;
-        std::shared_ptr<Timer> _timer;
-        std::shared_ptr<Ppu> _ppu;
+        // Instance being debugged
+        GameBoy &_gameboy;
+        Registers &_registers;
+        Mmu &_mmu;
+        Timer &_timer;
+        Ppu &_ppu;
+        Cpu &_cpu;
+        Gamepad &_gamepad;
         Disassembler _disassembler;
 
         std::map<std::string, std::string> _bytesBuffers;
@@ -93,7 +100,7 @@ namespace gasyboy
         std::vector<std::pair<std::string, bool>> _directions;
 
         void showByteArray(const std::vector<uint8_t> &data, const uint16_t &offset = 0, size_t bytes_per_row = 16);
-        void showByteArray(std::span<uint8_t> &data, const uint16_t &offset = 0, size_t bytes_per_row = 16, const bool &writable = false);
+        void showByteArray(std::span<const uint8_t> data, const uint16_t &offset = 0, size_t bytes_per_row = 16, const bool &writable = false);
         void showIntegerCombo(int a, int b, int &selected_value);
 
         void showPalette(const char *label, Colour palette[4], const uint8_t &w = 50, const uint8_t &h = 50);
@@ -101,6 +108,11 @@ namespace gasyboy
         void RenderSprite(const Mmu::Sprite &sprite);
         void renderPreviewSprite();
         void renderDisassemblerScreen();
+
+        // Hottest opcodes, banks and addresses, counted while the box is ticked
+        void renderExecutionStatsScreen();
+        void renderExecutionStatsTable(const char *id, const std::vector<ExecutionStats::Entry> &entries, const uint64_t &totalCycles,
+                                       const std::function<std::string(const size_t &)> &label);
     };
 }
 
@@ -1,5 +1,4 @@
 #include "disassembler.h"
-#include "mmuProvider.h"
 #include <exception>
 #include <stdexcept>
 #include <iostream>
@@ -8,9 +7,9 @@
 
 namespace gasyboy
 {
-    Disassembler::Disassembler()
+    Disassembler::Disassembler(Cartridge &cartridge)
     {
-        _rom = provider::MmuProvider::getInstance()->getCartridge().getRom();
+        _rom = cartridge.getRom();
 
         opcodeTable = {
             {1, 0x00, "NOP"},
@@ -531,7 +530,6 @@ namespace gasyboy
             {2, 0xFF, "SET 7, A"},
         };
 
-        auto &cartridge = provider::MmuProvider::getInstance()->getCartridge();
         _rom = cartridge.getRom();
     }
 
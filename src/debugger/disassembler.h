@@ -36,7 +36,7 @@ namespace gasyboy
         std::vector<Opcode> opcodeTable;
 
     public:
-        Disassembler();
+        Disassembler(Cartridge &cartridge);
 
         std::vector<OpcodeLine> disassembledRom;
 
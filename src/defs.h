@@ -3,7 +3,9 @@
 
 namespace gasyboy
 {
-#define MAXCYCLE 69905
+#define MAXCYCLE 70224
+#define CPU_FREQUENCY 4194304
+#define DMG_FRAME_RATE (static_cast<double>(CPU_FREQUENCY) / MAXCYCLE)
 #define SCALE 2
 #define SCREEN_WIDTH 160
 #define SCREEN_HEIGHT 144
@@ -0,0 +1,145 @@
+#include "executionStats.h"
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+
+namespace gasyboy
+{
+    namespace
+    {
+        void writeTable(std::ostringstream &out, const std::string &title, const std::vector<ExecutionStats::Entry> &entries,
+                        const uint64_t &totalCycles, const std::function<std::string(const size_t &)> &label)
+        {
+            out << "\n"
+                << title << "\n"
+                << std::left << std::setw(14) << "" << std::right
+                << std::setw(16) << "executions" << std::setw(16) << "cycles" << std::setw(9) << "cycles%" << "\n";
+
+            for (const auto &entry : entries)
+            {
+                const double share = totalCycles > 0 ? entry.counter.cycles * 100.0 / totalCycles : 0;
+                out << std::left << std::setw(14) << label(entry.index) << std::right
+                    << std::setw(16) << entry.counter.count
+                    << std::setw(16) << entry.counter.cycles
+                    << std::setw(8) << std::fixed << std::setprecision(2) << share << "%\n";
+            }
+        }
+
+        std::string hex(const size_t &value, const int &digits)
+        {
+            std::ostringstream out;
+            out << "0x" << std::uppercase << std::hex << std::setw(digits) << std::setfill('0') << value;
+            return out.str();
+        }
+    }
+
+    ExecutionStats::ExecutionStats()
+        : _banks(ROM_BANKS + 1),
+          _pcs(0x10000)
+    {
+        clear();
+    }
+
+    void ExecutionStats::clear()
+    {
+        _opcodes.fill({});
+        _cbOpcodes.fill({});
+        std::fill(_banks.begin(), _banks.end(), Counter{});
+        std::fill(_pcs.begin(), _pcs.end(), Counter{});
+        _cycleHistogram.fill(0);
+    }
+
+    const std::array<ExecutionStats::Counter, 256> &ExecutionStats::getOpcodes()
+    {
+        return _opcodes;
+    }
+
+    const std::array<ExecutionStats::Counter, 256> &ExecutionStats::getCbOpcodes()
+    {
+        return _cbOpcodes;
+    }
+
+    const std::vector<ExecutionStats::Counter> &ExecutionStats::getBanks()
+    {
+        return _banks;
+    }
+
+    const std::vector<ExecutionStats::Counter> &ExecutionStats::getPcs()
+    {
+        return _pcs;
+    }
+
+    const std::array<uint64_t, ExecutionStats::CYCLE_BUCKETS> &ExecutionStats::getCycleHistogram()
+    {
+        return _cycleHistogram;
+    }
+
+    ExecutionStats::Counter ExecutionStats::getTotal()
+    {
+        // Every instruction lands in exactly one bank
+        Counter total;
+        for (const auto &bank : _banks)
+        {
+            total.count += bank.count;
+            total.cycles += bank.cycles;
+        }
+        return total;
+    }
+
+    std::vector<ExecutionStats::Entry> ExecutionStats::sorted(const Counter *counters, const size_t &size, const size_t &limit)
+    {
+        std::vector<Entry> entries;
+        for (size_t i = 0; i < size; i++)
+        {
+            if (counters[i].count > 0)
+            {
+                entries.push_back({i, counters[i]});
+            }
+        }
+
+        const size_t kept = std::min(limit, entries.size());
+        std::partial_sort(entries.begin(), entries.begin() + kept, entries.end(), [](const Entry &a, const Entry &b)
+                          { return a.counter.cycles != b.counter.cycles ? a.counter.cycles > b.counter.cycles : a.index < b.index; });
+        entries.resize(kept);
+        return entries;
+    }
+
+    std::string ExecutionStats::report(const size_t &limit)
+    {
+        const Counter total = getTotal();
+
+        std::ostringstream out;
+        out << "Instructions: " << total.count << ", cycles: " << total.cycles << "\n"
+            << "\nInstruction length\n";
+        for (size_t i = 0; i < CYCLE_BUCKETS; i++)
+        {
+            const double share = total.count > 0 ? _cycleHistogram[i] * 100.0 / total.count : 0;
+            out << std::setw(4) << i * 4 << " cycles" << std::setw(16) << _cycleHistogram[i]
+                << std::setw(8) << std::fixed << std::setprecision(2) << share << "%\n";
+        }
+
+        writeTable(out, "Opcodes", sorted(_opcodes.data(), _opcodes.size(), limit), total.cycles, [](const size_t &index)
+                   { return hex(index, 2); });
+        writeTable(out, "CB opcodes", sorted(_cbOpcodes.data(), _cbOpcodes.size(), limit), total.cycles, [](const size_t &index)
+                   { return "0xCB " + hex(index, 2); });
+        writeTable(out, "ROM banks", sorted(_banks.data(), _banks.size(), limit), total.cycles, [](const size_t &index)
+                   { return index == OUTSIDE_ROM ? std::string("BIOS/RAM") : "bank " + std::to_string(index); });
+        writeTable(out, "Addresses", sorted(_pcs.data(), _pcs.size(), limit), total.cycles, [](const size_t &index)
+                   { return hex(index, 4); });
+
+        return out.str();
+    }
+
+    bool ExecutionStats::writeReport(const std::string &path, const size_t &limit)
+    {
+        std::ofstream file(path);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        file << report(limit);
+        return true;
+    }
+}
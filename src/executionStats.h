@@ -0,0 +1,88 @@
+#ifndef _EXECUTION_STATS_H_
+#define _EXECUTION_STATS_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gasyboy
+{
+    // Executions and cycles per opcode, per ROM bank and per PC, for finding the handlers and game
+    // routines worth optimizing. Every counter is a flat array indexed directly, recording is a few adds.
+    class ExecutionStats
+    {
+    public:
+        struct Counter
+        {
+            uint64_t count = 0;
+            uint64_t cycles = 0;
+        };
+
+        // A counter and what it counts: the opcode, the bank or the address
+        struct Entry
+        {
+            size_t index;
+            Counter counter;
+        };
+
+        // MBC5 maps up to 512 banks, code run from the BIOS or from RAM is counted after them
+        static constexpr size_t ROM_BANKS = 512;
+        static constexpr size_t OUTSIDE_ROM = ROM_BANKS;
+
+        // Instructions take up to 24 cycles, in steps of 4
+        static constexpr size_t CYCLE_BUCKETS = 7;
+
+        ExecutionStats();
+
+        // Bank is the ROM bank the PC is in, negative outside the ROM. CB opcodes are counted under cbOpcode only.
+        void record(const uint16_t &pc, const int &bank, const uint8_t &opcode, const uint8_t &cbOpcode, const long &cycles)
+        {
+            Counter &counter = opcode == 0xCB ? _cbOpcodes[cbOpcode] : _opcodes[opcode];
+            counter.count++;
+            counter.cycles += cycles;
+
+            Counter &bankCounter = _banks[bank >= 0 && bank < static_cast<int>(ROM_BANKS) ? bank : OUTSIDE_ROM];
+            bankCounter.count++;
+            bankCounter.cycles += cycles;
+
+            Counter &pcCounter = _pcs[pc];
+            pcCounter.count++;
+            pcCounter.cycles += cycles;
+
+            const size_t bucket = static_cast<size_t>(cycles / 4);
+            _cycleHistogram[bucket < CYCLE_BUCKETS ? bucket : CYCLE_BUCKETS - 1]++;
+        }
+
+        void clear();
+
+        const std::array<Counter, 256> &getOpcodes();
+        const std::array<Counter, 256> &getCbOpcodes();
+        const std::vector<Counter> &getBanks();
+        const std::vector<Counter> &getPcs();
+
+        // Instructions by the cycles they took, 0 first
+        const std::array<uint64_t, CYCLE_BUCKETS> &getCycleHistogram();
+
+        Counter getTotal();
+
+        // Counters that ran at least once, most cycles first, at most limit of them
+        static std::vector<Entry> sorted(const Counter *counters, const size_t &size, const size_t &limit);
+
+        // Sorted tables of every counter as text
+        std::string report(const size_t &limit);
+
+        // Write the report to a file, false when it cannot be opened
+        bool writeReport(const std::string &path, const size_t &limit);
+
+    private:
+        std::array<Counter, 256> _opcodes;
+        std::array<Counter, 256> _cbOpcodes;
+        std::vector<Counter> _banks;
+        std::vector<Counter> _pcs;
+        std::array<uint64_t, CYCLE_BUCKETS> _cycleHistogram;
+    };
+}
+
+#endif
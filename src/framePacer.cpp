@@ -0,0 +1,161 @@
+#include "framePacer.h"
+#include "defs.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace gasyboy
+{
+    FramePacer::FramePacer()
+        : _period(),
+          _started(false),
+          _enabled(true),
+          _spinMargin(std::chrono::milliseconds(2)),
+          _jitterHistogram(),
+          _frameCount(0),
+          _frameTimeSum(0),
+          _frameTimeSquaredSum(0)
+    {
+        setFrameRate(DMG_FRAME_RATE);
+    }
+
+    void FramePacer::setFrameRate(const double &framesPerSecond)
+    {
+        _period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / framesPerSecond));
+        reset();
+    }
+
+    double FramePacer::getFrameRate()
+    {
+        return 1.0 / std::chrono::duration<double>(_period).count();
+    }
+
+    void FramePacer::setEnabled(const bool &enabled)
+    {
+        _enabled = enabled;
+        reset();
+    }
+
+    bool FramePacer::isEnabled()
+    {
+        return _enabled;
+    }
+
+    void FramePacer::reset()
+    {
+        _started = false;
+    }
+
+    void FramePacer::wait()
+    {
+        auto now = Clock::now();
+
+        if (!_started)
+        {
+            _started = true;
+            _deadline = now + _period;
+            _lastFrame = now;
+            return;
+        }
+
+        if (_enabled && now < _deadline)
+        {
+            // Coarse sleep, waking up a margin before the deadline
+            const auto sleepTarget = _deadline - _spinMargin;
+            if (now < sleepTarget)
+            {
+                std::this_thread::sleep_until(sleepTarget);
+
+                // Track how late the OS wakes us and keep the spin margin a bit above it
+                const auto oversleep = Clock::now() - sleepTarget;
+                const auto margin = std::clamp<Clock::duration>(oversleep * 2,
+                                                                std::chrono::microseconds(200),
+                                                                std::chrono::milliseconds(4));
+                _spinMargin = (_spinMargin * 7 + margin) / 8;
+            }
+
+            // Fine spin up to the deadline
+            while (Clock::now() < _deadline)
+            {
+                std::this_thread::yield();
+            }
+
+            now = Clock::now();
+        }
+
+        recordFrameTime(now - _lastFrame);
+        _lastFrame = now;
+
+        // Absolute deadlines: an overshoot shortens the next wait instead of drifting
+        _deadline += _period;
+
+        // Too far behind (paused, debugger, slow host): restart from now instead of rushing frames
+        if (now - _deadline > _period * 4)
+        {
+            _deadline = now + _period;
+        }
+    }
+
+    void FramePacer::recordFrameTime(const Clock::duration &frameTime)
+    {
+        const double frameTimeMs = std::chrono::duration<double, std::milli>(frameTime).count();
+        const double deviationUs = std::chrono::duration<double, std::micro>(frameTime - _period).count();
+
+        int bucket = static_cast<int>(std::lround(deviationUs / JITTER_BUCKET_WIDTH_US)) + JITTER_BUCKETS / 2;
+        bucket = std::clamp(bucket, 0, JITTER_BUCKETS - 1);
+        _jitterHistogram[bucket]++;
+
+        _frameCount++;
+        _frameTimeSum += frameTimeMs;
+        _frameTimeSquaredSum += frameTimeMs * frameTimeMs;
+    }
+
+    const std::array<uint64_t, FramePacer::JITTER_BUCKETS> &FramePacer::getJitterHistogram()
+    {
+        return _jitterHistogram;
+    }
+
+    void FramePacer::clearJitterHistogram()
+    {
+        _jitterHistogram.fill(0);
+        _frameCount = 0;
+        _frameTimeSum = 0;
+        _frameTimeSquaredSum = 0;
+    }
+
+    std::string FramePacer::jitterReport()
+    {
+        std::stringstream report;
+        report << std::fixed << std::setprecision(3);
+
+        const double targetMs = std::chrono::duration<double, std::milli>(_period).count();
+        report << "Frame pacing: " << _frameCount << " frames, target " << targetMs << " ms";
+
+        if (_frameCount == 0)
+        {
+            return report.str();
+        }
+
+        const double mean = _frameTimeSum / _frameCount;
+        const double variance = std::max(0.0, _frameTimeSquaredSum / _frameCount - mean * mean);
+        report << ", mean " << mean << " ms, stddev " << std::sqrt(variance) << " ms\n";
+
+        const uint64_t peak = *std::max_element(_jitterHistogram.begin(), _jitterHistogram.end());
+        for (int i = 0; i < JITTER_BUCKETS; i++)
+        {
+            if (_jitterHistogram[i] == 0)
+                continue;
+
+            const int deviationUs = (i - JITTER_BUCKETS / 2) * JITTER_BUCKET_WIDTH_US;
+            const std::string bar(static_cast<size_t>(40 * _jitterHistogram[i] / peak), '#');
+
+            report << "\t" << std::showpos << std::setw(6) << deviationUs << std::noshowpos << " us"
+                   << (i == 0 || i == JITTER_BUCKETS - 1 ? "+" : " ")
+                   << " | " << std::setw(8) << _jitterHistogram[i] << " " << bar << "\n";
+        }
+
+        return report.str();
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef _FRAME_PACER_H_
+#define _FRAME_PACER_H_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace gasyboy
+{
+    // Paces frames against absolute steady_clock deadlines.
+    // It sleeps until shortly before the deadline and spins the rest of the way,
+    // the spin margin follows how late the OS actually wakes us up.
+    // Deadlines advance by exactly one period, so a late frame is made up by the next one
+    // instead of accumulating drift.
+    class FramePacer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        // Jitter histogram: deviation of each frame time from the period, in 250us buckets
+        // centered on 0. The first and last buckets also count everything beyond them.
+        static constexpr int JITTER_BUCKETS = 33;
+        static constexpr int JITTER_BUCKET_WIDTH_US = 250;
+
+        FramePacer();
+        ~FramePacer() = default;
+
+        // Target frame rate, DMG rate by default
+        void setFrameRate(const double &framesPerSecond);
+        double getFrameRate();
+
+        // When disabled (vsync matches the display), wait() only records frame times
+        void setEnabled(const bool &enabled);
+        bool isEnabled();
+
+        // Block until the current frame's deadline
+        void wait();
+
+        // Forget the deadline, e.g. after a pause
+        void reset();
+
+        const std::array<uint64_t, JITTER_BUCKETS> &getJitterHistogram();
+        void clearJitterHistogram();
+
+        // Histogram and frame time statistics as text
+        std::string jitterReport();
+
+    private:
+        Clock::duration _period;
+        Clock::time_point _deadline;
+        Clock::time_point _lastFrame;
+        bool _started;
+        bool _enabled;
+
+        // How early to stop sleeping and start spinning
+        Clock::duration _spinMargin;
+
+        std::array<uint64_t, JITTER_BUCKETS> _jitterHistogram;
+        uint64_t _frameCount;
+        double _frameTimeSum;
+        double _frameTimeSquaredSum;
+
+        void recordFrameTime(const Clock::duration &frameTime);
+    };
+}
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef _FRONTEND_H_
+#define _FRONTEND_H_
+
+#include "mmu.h"
+
+namespace gasyboy
+{
+    class GameBoy;
+
+    // Presentation side of the emulator, the core never talks to SDL directly
+    class IRenderer
+    {
+    public:
+        virtual ~IRenderer() = default;
+
+        // Attach to the core of the given instance
+        virtual void init(GameBoy &gameboy) = 0;
+        virtual void reset() = 0;
+
+        // Present the PPU framebuffer
+        virtual void render() = 0;
+
+        // Present a frame handed over by the emulation thread
+        virtual void render(const Colour *framebuffer) = 0;
+
+        // Tools refreshed every loop even without a new frame (the debugger)
+        virtual void renderDebugger() = 0;
+
+        // Vsync on a display running at the DMG rate, presenting paces the frames by itself
+        virtual bool isDisplayPaced() = 0;
+
+        // Called for every emulated frame, presented or not
+        virtual void countEmulatedFrame() = 0;
+
+        // Stereo frames waiting for the audio device and how many it can queue, 0 without a device
+        virtual size_t queuedAudioFrames() = 0;
+        virtual size_t audioCapacityFrames() = 0;
+    };
+
+    // Input side of the emulator, feeds the joypad and the emulator hotkeys
+    class IInputHandler
+    {
+    public:
+        virtual ~IInputHandler() = default;
+
+        // Attach to the instance whose joypad and hotkeys this feeds
+        virtual void init(GameBoy &gameboy) = 0;
+
+        // Poll pending events
+        virtual void handleEvent() = 0;
+
+        // Block until an event is pending or the timeout expires, used instead of spinning while idle
+        virtual void waitEvent(const int &timeoutMs) = 0;
+    };
+}
+
+#endif
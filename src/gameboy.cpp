@@ -1,74 +1,201 @@
-#include "interruptManagerProvider.h"
-#include "utilitiesProvider.h"
-#include "registersProvider.h"
-#include "gamepadProvider.h"
-#include "timerProvider.h"
-#include "ppuProvider.h"
-#include "cpuProvider.h"
-#include "mmuProvider.h"
 #include "gbException.h"
 #include "gameboy.h"
 #include "logger.h"
+#include "profiler.h"
+#include "utils.h"
+#include "nullFrontend.h"
+#include <algorithm>
+#include <cmath>
 #include <thread>
 #include <chrono>
-#ifndef EMSCRIPTEN
-#include "imgui_impl_sdl2.h"
-#endif
 
 namespace gasyboy
 {
-    GameBoy::State GameBoy::state = GameBoy::State::RUNNING;
-
-    GameBoy::GameBoy()
-        : _debugMode(provider::UtilitiesProvider::getInstance()->debugMode),
-          _gamepad(provider::GamepadProvider::getInstance()),
-          _mmu(provider::MmuProvider::getInstance()),
-          _registers(provider::RegistersProvider::getInstance()),
-          _interruptManager(provider::InterruptManagerProvider::getInstance()),
-          _cpu(provider::CpuProvider::getInstance()),
-          _timer(provider::TimerProvider::getInstance()),
+    GameBoy::GameBoy(std::shared_ptr<Utilities> utilities,
+                     std::unique_ptr<IRenderer> renderer, std::unique_ptr<IInputHandler> inputHandler)
+        : _utilities(utilities),
+          _timer(_interruptManager),
+          _gamepad(_registers),
+          _apu(*utilities),
+          _mmu(*utilities, _gamepad, _timer, _interruptManager, _apu),
+          _registers(_mmu, *utilities),
+          _interruptManager(_mmu, _registers),
+          _cpu(_mmu, _registers, _interruptManager, _timer, *utilities),
+          _ppu(_mmu, _registers, _interruptManager, *utilities),
+          _renderer(std::move(renderer)),
+          _inputHandler(std::move(inputHandler)),
           _cycleCounter(0),
-          _ppu(provider::PpuProvider::getInstance())
+          _totalCycles(0),
+          _debugMode(utilities->debugMode),
+          _pacedFrames(0),
+          _speed(utilities->speed),
+          _appliedSpeed(-1),
+          _audioSync(false),
+          _audioPaced(false),
+          _rewinding(false),
+          _rewindFrames(0),
+          _runAhead(0),
+          _runningAhead(false),
+          _runAheadFrameValid(false),
+          _realFrameSeconds(0),
+          _runAheadSeconds(0),
+          _movieFrame(0),
+          _movieDivergence(-1),
+          _threadedEmulation(false),
+          _emulationRunning(false),
+          _emulationFailed(false),
+          state(State::RUNNING)
     {
-        _renderer = std::make_unique<Renderer>();
-        _renderer->init();
+        // The frontend attaches to the core built above
+        _renderer->init(*this);
+        _inputHandler->init(*this);
 
 #ifndef EMSCRIPTEN
-        if (_debugMode)
-        {
-            _debugger = std::make_shared<Debugger>(_renderer->_window);
-        }
+        _threadedEmulation = !_debugMode && _utilities->threadedEmulation;
+
+        // The browser drives the main loop, it cannot block on the audio queue
+        _audioSync = _utilities->audioSync;
 #endif
+
+        applySpeed();
+        setupRewind();
+        setupRunAhead();
     }
 
-    GameBoy::GameBoy(const uint8_t *bytes, const size_t &romSize)
-        : _debugMode(provider::UtilitiesProvider::getInstance()->debugMode),
-          _gamepad(provider::GamepadProvider::getInstance()),
-          _mmu(provider::MmuProvider::create(bytes, romSize)),
-          _registers(provider::RegistersProvider::getInstance()),
-          _interruptManager(provider::InterruptManagerProvider::getInstance()),
-          _cpu(provider::CpuProvider::getInstance()),
-          _timer(provider::TimerProvider::getInstance()),
+    GameBoy::GameBoy(std::shared_ptr<Utilities> utilities, const uint8_t *bytes, const size_t &romSize,
+                     std::unique_ptr<IRenderer> renderer, std::unique_ptr<IInputHandler> inputHandler)
+        : _utilities(utilities),
+          _timer(_interruptManager),
+          _gamepad(_registers),
+          _apu(*utilities),
+          _mmu(*utilities, _gamepad, _timer, _interruptManager, _apu, bytes, romSize),
+          _registers(_mmu, *utilities),
+          _interruptManager(_mmu, _registers),
+          _cpu(_mmu, _registers, _interruptManager, _timer, *utilities),
+          _ppu(_mmu, _registers, _interruptManager, *utilities),
+          _renderer(std::move(renderer)),
+          _inputHandler(std::move(inputHandler)),
           _cycleCounter(0),
-          _ppu(provider::PpuProvider::getInstance())
+          _totalCycles(0),
+          _debugMode(utilities->debugMode),
+          _pacedFrames(0),
+          _speed(utilities->speed),
+          _appliedSpeed(-1),
+          _audioSync(false),
+          _audioPaced(false),
+          _rewinding(false),
+          _rewindFrames(0),
+          _runAhead(0),
+          _runningAhead(false),
+          _runAheadFrameValid(false),
+          _realFrameSeconds(0),
+          _runAheadSeconds(0),
+          _movieFrame(0),
+          _movieDivergence(-1),
+          _threadedEmulation(false),
+          _emulationRunning(false),
+          _emulationFailed(false),
+          state(State::RUNNING)
     {
-        _renderer = std::make_unique<Renderer>();
-        _renderer->init();
+        // The frontend attaches to the core built above
+        _renderer->init(*this);
+        _inputHandler->init(*this);
 
 #ifndef EMSCRIPTEN
-        if (_debugMode)
-        {
-            _debugger = std::make_unique<Debugger>(_renderer->_window);
-        }
+        _threadedEmulation = !_debugMode && _utilities->threadedEmulation;
+
+        // The browser drives the main loop, it cannot block on the audio queue
+        _audioSync = _utilities->audioSync;
 #endif
+
+        applySpeed();
+        setupRewind();
+        setupRunAhead();
+    }
+
+    GameBoy::GameBoy(std::shared_ptr<Utilities> utilities, GameBoy &parent)
+        : _utilities(utilities),
+          _timer(_interruptManager),
+          _gamepad(_registers),
+          _apu(*utilities),
+          _mmu(*utilities, _gamepad, _timer, _interruptManager, _apu, parent._mmu.getCartridge()),
+          _registers(_mmu, *utilities),
+          _interruptManager(_mmu, _registers),
+          _cpu(_mmu, _registers, _interruptManager, _timer, *utilities),
+          _ppu(_mmu, _registers, _interruptManager, *utilities),
+          _renderer(std::make_unique<NullRenderer>()),
+          _inputHandler(std::make_unique<NullInputHandler>()),
+          _cycleCounter(0),
+          _totalCycles(0),
+          _debugMode(false),
+          _pacedFrames(0),
+          _speed(utilities->speed),
+          _appliedSpeed(-1),
+          _audioSync(false),
+          _audioPaced(false),
+          _rewinding(false),
+          _rewindFrames(0),
+          _runAhead(0),
+          _runningAhead(false),
+          _runAheadFrameValid(false),
+          _realFrameSeconds(0),
+          _runAheadSeconds(0),
+          _movieFrame(0),
+          _movieDivergence(-1),
+          _threadedEmulation(false),
+          _emulationRunning(false),
+          _emulationFailed(false),
+          state(State::RUNNING)
+    {
+        _renderer->init(*this);
+        _inputHandler->init(*this);
+        applySpeed();
+    }
+
+    std::unique_ptr<GameBoy> GameBoy::fork()
+    {
+        auto utilities = std::make_shared<Utilities>(*_utilities);
+        utilities->debugMode = false;
+        utilities->threadedEmulation = false;
+        utilities->threadedPpu = false;
+        utilities->rewindSeconds = 0;
+        utilities->runAhead = 0;
+        utilities->speed = SPEED_UNCAPPED;
+        utilities->executionStatsPath.clear();
+
+        auto child = std::unique_ptr<GameBoy>(new GameBoy(utilities, *this));
+
+        _forkState.resize(saveStateSize());
+        saveState(_forkState.data(), _forkState.size());
+        child->loadState(_forkState.data(), _forkState.size());
+        child->state = state;
+
+        return child;
+    }
+
+    GameBoy::~GameBoy()
+    {
+        stopEmulationThread();
     }
 
     void GameBoy::step()
     {
-        const uint16_t cycle = static_cast<uint16_t>(_cpu->step());
+        // Joypad changes land between instructions, but not in run-ahead frames which are thrown away,
+        // and only at frame start with a movie
+        if (!_runningAhead && !_movieWriter && !_movie)
+        {
+            _gamepad.applyInput();
+        }
+
+        // Nothing can happen to a halted CPU before the next event, it is skipped to at once
+        const uint32_t cycle = _registers.getHalted() && !_registers.getStopMode() && !_interruptManager.hasPendingInterrupt()
+                                   ? haltCycles()
+                                   : static_cast<uint32_t>(_cpu.step());
         _cycleCounter += cycle;
-        _timer->update(cycle);
-        _ppu->step(cycle);
+        _totalCycles += cycle;
+        _timer.update(cycle);
+        _apu.update(cycle);
+        _ppu.step(cycle);
     }
 
     void GameBoy::stop()
@@ -78,6 +205,14 @@ namespace gasyboy
 
     void GameBoy::boot()
     {
+#ifndef EMSCRIPTEN
+        if (_threadedEmulation)
+        {
+            presentationLoop();
+            return;
+        }
+#endif
+
         bool running = true;
 
         try
@@ -95,109 +230,766 @@ namespace gasyboy
     }
 
     void GameBoy::loop()
+    {
+        advanceFrame();
+
+        _inputHandler->handleEvent();
+        _renderer->renderDebugger();
+
+        if (_ppu._canRender)
+        {
+            // Audio paced frames are presented as soon as they are done, the wait comes after
+            const bool audioPaced = _audioPaced;
+            if (!audioPaced)
+            {
+                paceFrame();
+            }
+            if (!skipFrame())
+            {
+                if (_runAheadFrameValid)
+                {
+                    _renderer->render(_runAheadFrame.data());
+                }
+                else
+                {
+                    _renderer->render();
+                }
+            }
+            if (audioPaced)
+            {
+                paceFrame();
+            }
+            _ppu._canRender = false;
+        }
+    }
+
+    bool GameBoy::runFrame()
     {
         _cycleCounter = 0;
+        bool emulated = false;
 
-        while ((Cpu::state == Cpu::State::RUNNING && _cycleCounter <= MAXCYCLE) ||
-               Cpu::state == Cpu::State::STEPPING ||
-               Cpu::state == Cpu::State::PAUSED) // Keep processing when paused
+        while ((_cpu.state == Cpu::State::RUNNING && _cycleCounter <= MAXCYCLE) ||
+               _cpu.state == Cpu::State::STEPPING ||
+               _cpu.state == Cpu::State::PAUSED) // Keep processing when paused
         {
-            _interruptManager->handleInterrupts();
+            // STOP freezes the whole system until a button is pressed, the host sleeps meanwhile.
+            // Movies and run-ahead frames only get input at frame start.
+            if (_registers.getStopMode() && _cpu.state == Cpu::State::RUNNING)
+            {
+                if (!_runningAhead && !_movie)
+                {
+                    waitForInput();
+                }
+                if (!_runningAhead && !_movieWriter && !_movie)
+                {
+                    _gamepad.applyInput();
+                }
+                if (_registers.getStopMode())
+                {
+                    // Nothing runs but the clock, the rest of the frame passes in 4 cycle steps
+                    const uint32_t idle = ((MAXCYCLE - _cycleCounter) / 4 + 1) * 4;
+                    _cycleCounter += idle;
+                    _totalCycles += idle;
+                    continue;
+                }
+            }
+
+            _interruptManager.handleInterrupts();
 
-            if (Cpu::state == Cpu::State::RUNNING || Cpu::state == Cpu::State::STEPPING)
+            if (_cpu.state == Cpu::State::RUNNING || _cpu.state == Cpu::State::STEPPING)
             {
                 step();
-                if (Cpu::state == Cpu::State::STEPPING)
+                emulated = true;
+                if (_cpu.state == Cpu::State::STEPPING)
                 {
-                    Cpu::state = Cpu::State::PAUSED;
+                    _cpu.state = Cpu::State::PAUSED;
                 }
             }
-            else if (Cpu::state == Cpu::State::PAUSED)
+            else if (_cpu.state == Cpu::State::PAUSED)
             {
-                if (_ppu->_debugRender)
+                if (_ppu._debugRender)
                 {
-                    _ppu->refresh();
+                    _ppu.refresh();
                     _renderer->render();
-                    _ppu->_debugRender = false;
+                    _ppu._debugRender = false;
                 }
 
-                _gamepad->handleEvent();
+                // Sleep until input or the next debugger refresh instead of spinning
+                _inputHandler->waitEvent(IDLE_WAIT_MS);
+                _inputHandler->handleEvent();
 
                 // Render debugger UI while paused
-#ifndef EMSCRIPTEN
-                if (_debugMode)
+                _renderer->renderDebugger();
+            }
+        }
+
+        return emulated;
+    }
+
+    void GameBoy::waitForInput()
+    {
+        // The emulation thread cannot touch SDL, input reaches it through the joypad queue
+        if (_threadedEmulation)
+        {
+            _gamepad.waitInput(std::chrono::milliseconds(IDLE_WAIT_MS));
+        }
+        else
+        {
+            _inputHandler->waitEvent(IDLE_WAIT_MS);
+            _inputHandler->handleEvent();
+        }
+    }
+
+    uint32_t GameBoy::haltCycles()
+    {
+        uint64_t cycles = std::min<uint64_t>(_ppu.cyclesToNextMode(), _timer.cyclesToOverflow());
+
+        // The frame loop stops once the counter is past MAXCYCLE
+        cycles = std::min<uint64_t>(cycles, _cycleCounter <= MAXCYCLE ? MAXCYCLE - _cycleCounter + 1 : MAXCYCLE);
+
+        return static_cast<uint32_t>(std::max<uint64_t>(1, (cycles + 3) / 4) * 4);
+    }
+
+    uint64_t GameBoy::runCycles(const uint64_t &cycles)
+    {
+        return runUntil(cycles, false);
+    }
+
+    bool GameBoy::runToFrameEnd()
+    {
+        const uint64_t frames = _ppu._frameCount;
+        runUntil(MAXCYCLE, true);
+        return _ppu._frameCount != frames;
+    }
+
+    uint64_t GameBoy::runUntil(const uint64_t &cycles, const bool &toFrameEnd)
+    {
+        const uint64_t start = _totalCycles;
+        const uint64_t frames = _ppu._frameCount;
+
+        while (_cpu.state == Cpu::State::RUNNING && _totalCycles - start < cycles &&
+               !(toFrameEnd && _ppu._frameCount != frames))
+        {
+            if (_registers.getStopMode())
+            {
+                if (!_runningAhead && !_movieWriter && !_movie)
                 {
-                    _debugger->render();
+                    _gamepad.applyInput();
+                }
+                if (_registers.getStopMode())
+                {
+                    // Frozen until a key press, the remaining cycles pass without emulating anything
+                    _totalCycles += (cycles - (_totalCycles - start) + 3) / 4 * 4;
+                    break;
                 }
-#endif
             }
+
+            _interruptManager.handleInterrupts();
+            step();
         }
+        _apu.endFrame();
 
-        _gamepad->handleEvent();
+        return _totalCycles - start;
+    }
 
-#ifndef EMSCRIPTEN
-        if (_debugMode)
+    void GameBoy::advanceFrame()
+    {
+        GASYBOY_PROFILE_SCOPE("GameBoy::advanceFrame");
+        GASYBOY_PROFILE_FRAME();
+
+        _runAheadFrameValid = false;
+
+        // A movie is a single timeline, it cannot be rewound
+        if (_rewindBuffer && !_movieWriter && !_movie &&
+            _rewinding.load(std::memory_order_relaxed) && _rewindBuffer->pop(_rewindState.data()))
         {
-            _debugger->render();
+            // The restored framebuffer is presented like a freshly emulated one
+            loadState(_rewindState.data(), _rewindState.size());
+            _ppu._canRender = true;
+            _rewindFrames = 0;
+            return;
         }
-#endif
 
-        if (_ppu->_canRender)
+        const bool playing = _movie && _movieFrame < _movie->frames.size();
+        bool woken = false;
+        if (playing)
+        {
+            const MovieFrame &frame = _movie->frames[_movieFrame];
+            _gamepad.setButtons(frame.buttons);
+            if (frame.wake)
+            {
+                _registers.setStopMode(false);
+            }
+        }
+        else if (_movieWriter || _movie)
+        {
+            // Live input takes over once the movie is over. A key that is not on the joypad
+            // wakes the CPU from STOP without changing the buttons, the wake-up is recorded too.
+            const bool stopped = _registers.getStopMode();
+            _gamepad.applyInput();
+            woken = stopped && !_registers.getStopMode();
+        }
+
+        const auto start = FramePacer::Clock::now();
+        const bool emulated = runFrame();
+        _apu.endFrame();
+        _realFrameSeconds += std::chrono::duration<double>(FramePacer::Clock::now() - start).count();
+
+        // Frames spent in STOP emulate nothing, they are not recorded nor rewound to.
+        // A movie being played still moves on, its frames only stay in STOP once it has diverged.
+        if (!emulated && !playing)
         {
-            _renderer->render();
-            _ppu->_canRender = false;
+            return;
+        }
+
+        if (_movieWriter)
+        {
+            _movieWriter->write({_gamepad.getButtons(), woken, stateHash()});
+        }
+        else if (playing)
+        {
+            if (_movieDivergence < 0 && stateHash() != _movie->frames[_movieFrame].stateHash)
+            {
+                _movieDivergence = static_cast<int64_t>(_movieFrame);
+                utils::Logger::getInstance()->log<utils::Logger::LogType::INFO>("Movie diverged at frame ", _movieFrame);
+            }
+            _movieFrame++;
+        }
+
+        if (_rewindBuffer && emulated && ++_rewindFrames >= _utilities->rewindInterval)
+        {
+            saveState(_rewindState.data(), _rewindState.size());
+            _rewindBuffer->push(_rewindState.data());
+            _rewindFrames = 0;
+        }
+
+        if (_runAhead > 0 && _ppu._canRender)
+        {
+            runAheadFrames();
         }
     }
 
-    void GameBoy::reset()
+    void GameBoy::runAheadFrames()
     {
-        // Saving RAM to file
-        gasyboy::provider::MmuProvider::getInstance()->saveRam();
+        const auto start = FramePacer::Clock::now();
+
+        // Input queued so far is part of the real timeline, run-ahead frames all see it
+        _gamepad.applyInput();
+        saveState(_runAheadState.data(), _runAheadState.size());
+
+        // Frames run ahead are heard once they become real
+        _runningAhead = true;
+        _apu.setMuted(true);
+        for (int frame = 0; frame < _runAhead; frame++)
+        {
+            runFrame();
+        }
+        _runningAhead = false;
+
+        // The last frame run ahead may still be on the render worker
+        _ppu.finishRendering();
+        {
+            std::lock_guard<std::mutex> lock(_ppu._framebufferMutex);
+            std::copy(_ppu._framebuffer, _ppu._framebuffer + SCREEN_WIDTH * SCREEN_HEIGHT, _runAheadFrame.begin());
+        }
+        _runAheadFrameValid = true;
+
+        loadState(_runAheadState.data(), _runAheadState.size());
+        _apu.setMuted(false);
+
+        _runAheadSeconds += std::chrono::duration<double>(FramePacer::Clock::now() - start).count();
+    }
+
+    void GameBoy::setupRunAhead()
+    {
+        _runAheadFrameValid = false;
+        _realFrameSeconds = 0;
+        _runAheadSeconds = 0;
+
+        // The debugger pauses mid-frame, whole frames cannot be replayed there
+        _runAhead = _debugMode ? 0 : std::max(0, _utilities->runAhead);
+        _runAheadState.resize(_runAhead > 0 ? saveStateSize() : 0);
+    }
+
+    const Colour *GameBoy::presentedFrame()
+    {
+        return _runAheadFrameValid ? _runAheadFrame.data() : _ppu._framebuffer;
+    }
 
-        Cartridge previousCartridge;
-        if (provider::UtilitiesProvider::getInstance()->wasReset)
+    void GameBoy::setupRewind()
+    {
+        _rewindBuffer.reset();
+        _rewindFrames = 0;
+
+        // The debugger steps instructions, snapshots are only taken on whole frames
+        if (_debugMode || _utilities->rewindSeconds <= 0)
         {
-            previousCartridge = gasyboy::provider::MmuProvider::getInstance()->getCartridge();
+            _rewindState.clear();
+            return;
         }
 
-        gasyboy::provider::GamepadProvider::deleteInstance();
-        gasyboy::provider::MmuProvider::deleteInstance();
-        gasyboy::provider::RegistersProvider::deleteInstance();
-        gasyboy::provider::InterruptManagerProvider::deleteInstance();
-        gasyboy::provider::CpuProvider::deleteInstance();
-        gasyboy::provider::TimerProvider::deleteInstance();
-        gasyboy::provider::PpuProvider::deleteInstance();
+        const int interval = std::max(1, _utilities->rewindInterval);
+        const size_t snapshots = static_cast<size_t>(_utilities->rewindSeconds * DMG_FRAME_RATE / interval);
+
+        _rewindState.resize(saveStateSize());
+        _rewindBuffer = std::make_unique<RewindBuffer>(_rewindState.size(), snapshots);
+    }
+
+    void GameBoy::setRewinding(const bool &rewinding)
+    {
+        _rewinding = rewinding;
+    }
+
+    void GameBoy::recordMovie(const std::string &path)
+    {
+        reset();
+
+        _movieWriter = std::make_unique<MovieWriter>(path, _mmu.getCartridge().getRomHash(), _utilities->executeBios);
+    }
+
+    void GameBoy::playMovie(const std::string &path)
+    {
+        auto movie = std::make_unique<Movie>(Movie::load(path));
+
+        _utilities->executeBios = movie->executeBios;
+        reset();
+
+        if (movie->romHash != _mmu.getCartridge().getRomHash())
+        {
+            throw exception::GbException("Movie was recorded with another ROM: " + path);
+        }
+
+        _movie = std::move(movie);
+        _movieFrame = 0;
+        _movieDivergence = -1;
+    }
+
+    size_t GameBoy::getMovieFrame()
+    {
+        return _movieFrame;
+    }
+
+    size_t GameBoy::getMovieLength()
+    {
+        return _movie ? _movie->frames.size() : 0;
+    }
+
+    int64_t GameBoy::getMovieDivergence()
+    {
+        return _movieDivergence;
+    }
+
+    void GameBoy::writeExecutionStats()
+    {
+        ExecutionStats *stats = _cpu.getExecutionStats();
+        if (!stats || _utilities->executionStatsPath.empty())
+        {
+            return;
+        }
+
+        if (stats->writeReport(_utilities->executionStatsPath, EXECUTION_STATS_ROWS))
+        {
+            utils::Logger::getInstance()->log(utils::Logger::LogType::FUNCTIONAL,
+                                              "Execution stats written to " + _utilities->executionStatsPath);
+        }
+        else
+        {
+            utils::Logger::getInstance()->log(utils::Logger::LogType::CRITICAL,
+                                              "Unable to write execution stats to " + _utilities->executionStatsPath);
+        }
+    }
+
+    uint64_t GameBoy::stateHash()
+    {
+        const uint16_t registers[6] = {_registers.AF.get(), _registers.BC.get(), _registers.DE.get(),
+                                       _registers.HL.get(), _registers.SP, _registers.PC};
+
+        uint64_t hash = utils::hash64(registers, sizeof(registers));
+        hash = utils::hash64(&_mmu._memory[0x8000], 0x2000, hash);
+        return utils::hash64(&_mmu._memory[0xC000], 0x2000, hash);
+    }
+
+    void GameBoy::paceFrame()
+    {
+        _renderer->countEmulatedFrame();
+
+        applySpeed();
+        applyAudioSync();
+
+        if (_audioPaced)
+        {
+            _apu.setRateRatio(_audioPacer.wait([this]
+                                               { return _renderer->queuedAudioFrames(); }));
+        }
+
+        // Disabled while audio paced, it then only records the frame time
+        _framePacer.wait();
+
+        // Roughly once per second
+        if (_utilities->frameStats && ++_pacedFrames >= 60)
+        {
+            utils::Logger::getInstance()->log<utils::Logger::LogType::INFO>(_framePacer.jitterReport());
+            _framePacer.clearJitterHistogram();
+
+            if (_audioPaced)
+            {
+                utils::Logger::getInstance()->log<utils::Logger::LogType::INFO>("Audio sync: ", std::lround(_audioPacer.getAverageFill()), "/",
+                                                                                _renderer->audioCapacityFrames(), " frames queued, rate ratio ",
+                                                                                _audioPacer.getRatio());
+            }
+
+            if (_runAhead > 0 && _realFrameSeconds > 0)
+            {
+                utils::Logger::getInstance()->log<utils::Logger::LogType::INFO>("Run-ahead ", _runAhead, ": ",
+                                                                                _runAheadSeconds * 1000.0 / _pacedFrames, " ms/frame, +",
+                                                                                std::lround(_runAheadSeconds * 100.0 / _realFrameSeconds), "% CPU");
+            }
+            _realFrameSeconds = 0;
+            _runAheadSeconds = 0;
+            _pacedFrames = 0;
+        }
+    }
+
+    void GameBoy::applySpeed()
+    {
+        const int speed = _speed.load(std::memory_order_relaxed);
+        if (speed == _appliedSpeed)
+        {
+            return;
+        }
+        _appliedSpeed = speed;
+
+        if (speed == SPEED_UNCAPPED)
+        {
+            _framePacer.setEnabled(false);
+            return;
+        }
+
+        // At 1x on a single thread, vsync on a DMG rate display already paces the frames
+        _framePacer.setFrameRate(DMG_FRAME_RATE * speed);
+        _framePacer.setEnabled(!_audioPaced && (_threadedEmulation || speed != 1 || !_renderer->isDisplayPaced()));
+    }
+
+    void GameBoy::applyAudioSync()
+    {
+        const bool audioPaced = _audioSync && _appliedSpeed == 1 &&
+                                !_rewinding.load(std::memory_order_relaxed) && _renderer->audioCapacityFrames() > 0;
+        if (audioPaced == _audioPaced)
+        {
+            return;
+        }
+        _audioPaced = audioPaced;
+
+        // Hold half the ring, enough slack for a late frame without adding much latency
+        _audioPacer.setup(_renderer->audioCapacityFrames() / 2, _apu.getSampleRate() / DMG_FRAME_RATE,
+                          !_threadedEmulation && _renderer->isDisplayPaced());
+        _apu.setRateRatio(1);
+
+        // Set the frame pacer up again for the new mode
+        _appliedSpeed = -1;
+        applySpeed();
+    }
+
+    bool GameBoy::skipFrame()
+    {
+        if (_appliedSpeed == 1)
+        {
+            return false;
+        }
+
+        const auto now = FramePacer::Clock::now();
+        if (now - _lastPresent < std::chrono::duration<double>(1.0 / DMG_FRAME_RATE))
+        {
+            return true;
+        }
+
+        _lastPresent = now;
+        return false;
+    }
+
+    void GameBoy::setSpeed(const int &speed)
+    {
+        _speed = speed;
+
+        utils::Logger::getInstance()->log(utils::Logger::LogType::INFO,
+                                          speed == SPEED_UNCAPPED ? "Speed: uncapped" : "Speed: " + std::to_string(speed) + "x");
+    }
+
+    int GameBoy::getSpeed()
+    {
+        return _speed;
+    }
+
+    void GameBoy::cycleSpeed()
+    {
+        switch (_speed.load())
+        {
+        case 1:
+            setSpeed(2);
+            break;
+        case 2:
+            setSpeed(4);
+            break;
+        case 4:
+            setSpeed(SPEED_UNCAPPED);
+            break;
+        default:
+            setSpeed(1);
+            break;
+        }
+    }
+
+    void GameBoy::publishFrame()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_ppu._framebufferMutex);
+            const Colour *frame = presentedFrame();
+            std::copy(frame, frame + SCREEN_WIDTH * SCREEN_HEIGHT, _frames.back().begin());
+        }
+        _frames.publish();
+    }
+
+    void GameBoy::emulationLoop()
+    {
+        try
+        {
+            while (_emulationRunning.load(std::memory_order_relaxed))
+            {
+                advanceFrame();
+
+                if (_ppu._canRender)
+                {
+                    if (!skipFrame())
+                    {
+                        publishFrame();
+                    }
+                    _ppu._canRender = false;
+                    paceFrame();
+                }
+            }
+        }
+        catch (const exception::GbException &e)
+        {
+            utils::Logger::getInstance()->log(utils::Logger::LogType::CRITICAL, e.what());
+            _emulationFailed = true;
+        }
+    }
+
+    void GameBoy::presentationLoop()
+    {
+        startEmulationThread();
+
+        while (!_emulationFailed)
+        {
+            // May reset the gameboy, which restarts the emulation thread
+            _inputHandler->handleEvent();
+
+            if (_frames.update())
+            {
+                _renderer->render(_frames.front().data());
+            }
+            else
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        stopEmulationThread();
+    }
+
+    void GameBoy::startEmulationThread()
+    {
+        _emulationFailed = false;
+        _emulationRunning = true;
+        _emulationThread = std::thread(&GameBoy::emulationLoop, this);
+    }
+
+    bool GameBoy::stopEmulationThread()
+    {
+        if (!_emulationThread.joinable())
+        {
+            return false;
+        }
+
+        _emulationRunning = false;
+
+        // exit() called from the core runs destructors on the emulation thread itself
+        if (std::this_thread::get_id() == _emulationThread.get_id())
+        {
+            _emulationThread.detach();
+        }
+        else
+        {
+            _emulationThread.join();
+        }
+
+        return true;
+    }
+
+    void GameBoy::reset()
+    {
+        // The core is reset in place, the emulation thread must not touch it meanwhile
+        const bool restartEmulationThread = stopEmulationThread();
+
+        // Saving RAM to file
+        _mmu.saveRam();
+
+        // A movie covers a single run from power-on
+        _movieWriter.reset();
+        _movie.reset();
+
 #ifndef EMSCRIPTEN
-        if (_debugMode)
+        if (!_utilities->newRomFilePath.empty())
         {
-            _debugger->reset();
+            _utilities->romFilePath = _utilities->newRomFilePath;
         }
-        provider::UtilitiesProvider::getInstance()->romFilePath = provider::UtilitiesProvider::getInstance()->newRomFilePath;
 #endif
 
-        gasyboy::provider::GamepadProvider::getInstance()->reset();
-        gasyboy::provider::MmuProvider::getInstance()->reset();
-        if (provider::UtilitiesProvider::getInstance()->wasReset)
-        {
-            gasyboy::provider::MmuProvider::getInstance()->setCartridge(previousCartridge);
-        }
-        gasyboy::provider::RegistersProvider::getInstance()->reset();
-        gasyboy::provider::InterruptManagerProvider::getInstance()->reset();
-        gasyboy::provider::CpuProvider::getInstance()->reset();
-        gasyboy::provider::TimerProvider::getInstance()->reset();
-        gasyboy::provider::PpuProvider::getInstance()->reset();
-
-        _debugMode = provider::UtilitiesProvider::getInstance()->debugMode;
-        _gamepad = provider::GamepadProvider::getInstance();
-        _mmu = provider::MmuProvider::getInstance();
-        _registers = provider::RegistersProvider::getInstance();
-        _interruptManager = provider::InterruptManagerProvider::getInstance();
-        _cpu = provider::CpuProvider::getInstance();
-        _timer = provider::TimerProvider::getInstance();
-        _cycleCounter = 0;
-        _ppu = provider::PpuProvider::getInstance();
-        _cpu->state = Cpu::State::RUNNING;
+        _gamepad.reset();
+        _mmu.reset();
+        _registers.reset();
+        _interruptManager.reset();
+        _cpu.reset();
+        _timer.reset();
+        _apu.reset();
+        _ppu.reset();
+
+        _debugMode = _utilities->debugMode;
+        _cpu.state = Cpu::State::RUNNING;
         _cycleCounter = 0;
+        _totalCycles = 0;
         _renderer->reset();
+        _framePacer.reset();
+        _audioPacer.reset();
+        setupRewind();
+        setupRunAhead();
+
+        if (restartEmulationThread)
+        {
+            startEmulationThread();
+        }
+    }
+
+    uint64_t GameBoy::getCycleCount()
+    {
+        return _totalCycles;
+    }
+
+    size_t GameBoy::saveStateSize()
+    {
+        return saveState(nullptr, 0);
+    }
+
+    size_t GameBoy::saveState(uint8_t *buffer, const size_t &capacity)
+    {
+        auto &cartridge = _mmu.getCartridge();
+
+        // The total size is only known at the end, it is patched in afterwards
+        StateWriter writer(buffer, capacity);
+        writer.write32(SAVE_STATE_MAGIC);
+        writer.write16(SAVE_STATE_VERSION);
+        writer.write16(0);
+        writer.write32(0);
+        writer.write64(cartridge.getRomHash());
+
+        _registers.saveState(writer);
+        _cpu.saveState(writer);
+        _interruptManager.saveState(writer);
+        _timer.saveState(writer);
+        _apu.saveState(writer);
+        _gamepad.saveState(writer);
+        _mmu.saveState(writer);
+        _ppu.saveState(writer);
+        writer.write32(static_cast<uint32_t>(_cycleCounter));
+        writer.write64(_totalCycles);
+
+        const size_t size = writer.size();
+        if (buffer)
+        {
+            StateWriter header(buffer + 8, 4);
+            header.write32(static_cast<uint32_t>(size));
+        }
+        return size;
+    }
+
+    void GameBoy::loadState(const uint8_t *buffer, const size_t &size)
+    {
+        StateReader reader(buffer, size);
+        if (reader.read32() != SAVE_STATE_MAGIC)
+        {
+            throw exception::GbException("Not a save state");
+        }
+        if (reader.read16() != SAVE_STATE_VERSION)
+        {
+            throw exception::GbException("Unsupported save state version");
+        }
+        reader.read16();
+
+        // A size that differs from ours means another cartridge RAM size or a corrupt state,
+        // it is rejected here rather than halfway through loading
+        if (reader.read32() != size || size != saveStateSize())
+        {
+            throw exception::GbException("Save state size mismatch");
+        }
+        if (reader.read64() != _mmu.getCartridge().getRomHash())
+        {
+            throw exception::GbException("Save state is for another ROM");
+        }
+
+        _registers.loadState(reader);
+        _cpu.loadState(reader);
+        _interruptManager.loadState(reader);
+        _timer.loadState(reader);
+        _apu.loadState(reader);
+        _gamepad.loadState(reader);
+        _mmu.loadState(reader);
+        _ppu.loadState(reader);
+        _cycleCounter = static_cast<int>(reader.read32());
+        _totalCycles = reader.read64();
+    }
+
+    Utilities &GameBoy::getUtilities()
+    {
+        return *_utilities;
+    }
+
+    Mmu &GameBoy::getMmu()
+    {
+        return _mmu;
+    }
+
+    Cpu &GameBoy::getCpu()
+    {
+        return _cpu;
+    }
+
+    Ppu &GameBoy::getPpu()
+    {
+        return _ppu;
+    }
+
+    Registers &GameBoy::getRegisters()
+    {
+        return _registers;
+    }
+
+    Timer &GameBoy::getTimer()
+    {
+        return _timer;
+    }
+
+    Apu &GameBoy::getApu()
+    {
+        return _apu;
+    }
+
+    InterruptManager &GameBoy::getInterruptManager()
+    {
+        return _interruptManager;
+    }
+
+    Gamepad &GameBoy::getGamepad()
+    {
+        return _gamepad;
     }
 }
@@ -1,21 +1,23 @@
 #ifndef _GAMEBOY_H_
 #define _GAMEBOY_H_
 
-#ifdef EMSCRIPTEN
-#include <SDL2/SDL.h>
-#else
-#include "SDL.h"
-#include "debugger.h"
-#endif
-
 #include "mmu.h"
 #include "cpu.h"
 #include "ppu.h"
 #include "defs.h"
+#include "utilities.h"
 #include "timer.h"
+#include "apu.h"
 #include "gamepad.h"
-#include "renderer.h"
+#include "frontend.h"
 #include "interruptManager.h"
+#include "tripleBuffer.h"
+#include "framePacer.h"
+#include "audioPacer.h"
+#include "rewindBuffer.h"
+#include "movie.h"
+#include <atomic>
+#include <thread>
 #include <mutex>
 #include <condition_variable>
 
@@ -23,28 +25,146 @@ namespace gasyboy
 {
     class GameBoy
     {
-        std::shared_ptr<Mmu> _mmu;
-        std::shared_ptr<Registers> _registers;
-        std::shared_ptr<Cpu> _cpu;
-        std::shared_ptr<Timer> _timer;
-        std::shared_ptr<Gamepad> _gamepad;
-        std::shared_ptr<InterruptManager> _interruptManager;
-        std::shared_ptr<Ppu> _ppu;
-        std::unique_ptr<Renderer> _renderer;
+        // Settings of this instance, shared with the frontend
+        std::shared_ptr<Utilities> _utilities;
+
+        // The core, components are wired to each other by reference in declaration order
+        Timer _timer;
+        Gamepad _gamepad;
+        Apu _apu;
+        Mmu _mmu;
+        Registers _registers;
+        InterruptManager _interruptManager;
+        Cpu _cpu;
+        Ppu _ppu;
+
+        std::unique_ptr<IRenderer> _renderer;
+        std::unique_ptr<IInputHandler> _inputHandler;
 
         int _cycleCounter;
 
-        SDL_Window *_window;
-        SDL_Rect _tile_map_pos, _bg_map_pos;
-#ifndef EMSCRIPTEN
-        std::shared_ptr<Debugger> _debugger;
-#endif
+        // Cycles emulated since boot or the last reset
+        uint64_t _totalCycles;
+
         bool _debugMode;
 
+        // Paces emulated frames to the DMG refresh rate times the speed multiplier
+        FramePacer _framePacer;
+        int _pacedFrames;
+
+        // Speed requested (possibly from another thread) and speed the pacer is set up for
+        std::atomic<int> _speed;
+        int _appliedSpeed;
+
+        // Last frame presented, when running faster than 1x
+        FramePacer::Clock::time_point _lastPresent;
+
+        // With audio sync, frames at 1x are paced by the audio device queue instead of the frame pacer.
+        // Fast-forward and rewind produce no sound and fall back to the frame pacer.
+        AudioPacer _audioPacer;
+        bool _audioSync;
+        bool _audioPaced;
+
+        // Snapshots taken every rewindInterval frames, played back in reverse while rewinding
+        std::unique_ptr<RewindBuffer> _rewindBuffer;
+        std::vector<uint8_t> _rewindState;
+        std::atomic<bool> _rewinding;
+        int _rewindFrames;
+
+        // Run-ahead: the state is saved after each real frame, _runAhead more frames are emulated
+        // with the current input, the last one is kept for presentation and the state is restored
+        int _runAhead;
+        bool _runningAhead;
+        bool _runAheadFrameValid;
+        std::vector<uint8_t> _runAheadState;
+        std::array<Colour, SCREEN_WIDTH * SCREEN_HEIGHT> _runAheadFrame;
+
+        // Wall time spent on real and on run-ahead frames, for the frame stats
+        double _realFrameSeconds;
+        double _runAheadSeconds;
+
+        // Scratch state for fork()
+        std::vector<uint8_t> _forkState;
+
+        // Forked instance, sharing the parent's ROM
+        GameBoy(std::shared_ptr<Utilities> utilities, GameBoy &parent);
+
+        // Movies apply input once per frame instead of between instructions, so replays are exact
+        std::unique_ptr<MovieWriter> _movieWriter;
+        std::unique_ptr<Movie> _movie;
+        size_t _movieFrame;
+        int64_t _movieDivergence;
+
+        // Emulation on its own thread, native builds outside debug mode only.
+        // The main thread polls SDL and presents the newest frame published in _frames.
+        bool _threadedEmulation;
+        std::thread _emulationThread;
+        std::atomic<bool> _emulationRunning;
+        std::atomic<bool> _emulationFailed;
+        TripleBuffer<std::array<Colour, SCREEN_WIDTH * SCREEN_HEIGHT>> _frames;
+
+        // Run the CPU for one frame worth of cycles, false if it spent all of it in STOP
+        bool runFrame();
+
+        // Body of runCycles() and runToFrameEnd()
+        uint64_t runUntil(const uint64_t &cycles, const bool &toFrameEnd);
+
+        // Longest sleep while paused or in STOP mode, the debugger UI and window events keep refreshing at this rate
+        static constexpr int IDLE_WAIT_MS = 33;
+
+        // Rows of each table in the execution stats report
+        static constexpr size_t EXECUTION_STATS_ROWS = 64;
+
+        // Sleep until input arrives or IDLE_WAIT_MS pass
+        void waitForInput();
+
+        // Cycles a halted CPU can skip at once: its 4 cycle steps up to the one in which the next
+        // PPU mode change, timer overflow or end of frame lands
+        uint32_t haltCycles();
+
+        // Run a frame, or step back one snapshot while rewinding
+        void advanceFrame();
+
+        // Rewind history is dropped when the core is reset
+        void setupRewind();
+
+        // Emulate the run-ahead frames and come back to the real one
+        void runAheadFrames();
+        void setupRunAhead();
+
+        // Frame to present: the run-ahead one when there is one, the PPU framebuffer otherwise
+        const Colour *presentedFrame();
+
+        // Wait for the frame deadline
+        void paceFrame();
+
+        // Set the pacer up for the requested speed
+        void applySpeed();
+
+        // Switch between the audio and the frame pacer when the speed or rewinding changes
+        void applyAudioSync();
+
+        // Above 1x, frames coming faster than the display rate are not presented
+        bool skipFrame();
+
+        // Copy the finished frame into the triple buffer
+        void publishFrame();
+
+        void emulationLoop();
+        void presentationLoop();
+        void startEmulationThread();
+
     public:
-        GameBoy();
-        GameBoy(const uint8_t *bytes, const size_t &romSize);
-        ~GameBoy() = default;
+        // Load the ROM from the configured path, or from memory
+        GameBoy(std::shared_ptr<Utilities> utilities,
+                std::unique_ptr<IRenderer> renderer, std::unique_ptr<IInputHandler> inputHandler);
+        GameBoy(std::shared_ptr<Utilities> utilities, const uint8_t *bytes, const size_t &romSize,
+                std::unique_ptr<IRenderer> renderer, std::unique_ptr<IInputHandler> inputHandler);
+        ~GameBoy();
+
+        // Components reference each other, an instance cannot be copied
+        GameBoy(const GameBoy &) = delete;
+        GameBoy &operator=(const GameBoy &) = delete;
 
         // Start the emulator
         void boot();
@@ -62,13 +182,82 @@ namespace gasyboy
             PAUSED
         };
 
-        static State state;
+        State state;
 
         // Used for the main loop
         void loop();
 
         // Reset the gameboy
         void reset();
+
+        // Run at least this many cycles, stopping at the first instruction boundary past them.
+        // Nothing is presented, paced, recorded or rewound. Returns the cycles actually run,
+        // in STOP mode the clock keeps running with nothing emulated.
+        uint64_t runCycles(const uint64_t &cycles);
+
+        // Same, but stop as soon as the PPU completes a frame, so the framebuffer is whole (with inline
+        // rendering). Gives up after a frame worth of cycles when the LCD is off. Returns whether a frame completed.
+        bool runToFrameEnd();
+
+        // Join the emulation thread, returns false if it was not running
+        bool stopEmulationThread();
+
+        // Speed multiplier: 1, 2, 4 or SPEED_UNCAPPED
+        static constexpr int SPEED_UNCAPPED = 0;
+        void setSpeed(const int &speed);
+        int getSpeed();
+
+        // 1x -> 2x -> 4x -> uncapped -> 1x
+        void cycleSpeed();
+
+        // Play the rewind history backwards while set, can be called from any thread
+        void setRewinding(const bool &rewinding);
+
+        // Reset and record the joypad every frame into a movie file
+        void recordMovie(const std::string &path);
+
+        // Reset and replay a movie, checking the state hash of every frame
+        void playMovie(const std::string &path);
+
+        // Frames of the movie played so far and in total
+        size_t getMovieFrame();
+        size_t getMovieLength();
+
+        // First frame whose state did not match the movie, -1 if none so far
+        int64_t getMovieDivergence();
+
+        // Write the sorted instruction counters to Utilities::executionStatsPath, if it is set
+        void writeExecutionStats();
+
+        // Hash of the CPU registers, VRAM and WRAM
+        uint64_t stateHash();
+
+        // Headless copy of this instance in its current state, for searching over inputs.
+        // The ROM is shared, everything else is copied through a save state (no disk access, no logging).
+        // The copy runs single threaded without rewind, run-ahead, movie or serial handler.
+        std::unique_ptr<GameBoy> fork();
+
+        // Cycles emulated since boot or the last reset
+        uint64_t getCycleCount();
+
+        // Save states go to and come from a caller-owned buffer, nothing is allocated.
+        // Only call these from the thread running the core, between frames or steps.
+        size_t saveStateSize();
+        size_t saveState(uint8_t *buffer, const size_t &capacity);
+
+        // The state is checked against this ROM before anything is loaded
+        void loadState(const uint8_t *buffer, const size_t &size);
+
+        // Components of this instance
+        Utilities &getUtilities();
+        Mmu &getMmu();
+        Cpu &getCpu();
+        Ppu &getPpu();
+        Registers &getRegisters();
+        Timer &getTimer();
+        Apu &getApu();
+        InterruptManager &getInterruptManager();
+        Gamepad &getGamepad();
     };
 }
 
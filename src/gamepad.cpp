@@ -1,156 +1,82 @@
-#include "utilitiesProvider.h"
-#include "gameBoyProvider.h"
-#include "registersProvider.h"
+#include "registers.h"
 #include "gamepad.h"
 #include "defs.h"
-#ifdef EMSCRIPTEN
-#include <SDL2/SDL.h>
-#else
-#include "SDL.h"
-#endif
 
 namespace gasyboy
 {
-    bool Gamepad::_buttonSelected = false;
-
-    Gamepad::Gamepad()
-        : _changedPalette(false),
+    Gamepad::Gamepad(Registers &registers)
+        : _registers(registers),
+          _buttonSelected(false),
+          _changedPalette(false),
           _state(0xFF)
     {
     }
 
     void Gamepad::reset()
     {
+        _buttonSelected = false;
         _changedPalette = false;
         _state = 0xFF;
+        _inputQueue.clear();
+    }
+
+    void Gamepad::saveState(StateWriter &writer)
+    {
+        writer.writeBool(_buttonSelected);
+        writer.write8(static_cast<uint8_t>(_state.to_ulong()));
+        writer.writeBool(_changedPalette);
     }
 
-    void Gamepad::handleEvent()
+    void Gamepad::loadState(StateReader &reader)
     {
-        SDL_Event event;
+        _buttonSelected = reader.readBool();
+        _state = reader.read8();
+        _changedPalette = reader.readBool();
+    }
+
+    void Gamepad::queueInput(const int &button, const bool &pressed)
+    {
+        // Only fills up if the emulation thread is gone, the event is dropped then
+        _inputQueue.push({static_cast<int8_t>(button), pressed});
 
-        while (SDL_PollEvent(&event) != 0)
+        // Taking the lock orders the push before a waiter's check, no wake-up is lost
         {
-#ifndef EMSCRIPTEN
-            if (provider::UtilitiesProvider::getInstance()->debugMode)
-            {
-                ImGui_ImplSDL2_ProcessEvent(&event);
-            }
-#endif
+            std::lock_guard<std::mutex> lock(_inputMutex);
+        }
+        _inputQueued.notify_one();
+    }
 
-            if (event.type == SDL_QUIT)
+    void Gamepad::waitInput(const std::chrono::milliseconds &timeout)
+    {
+        std::unique_lock<std::mutex> lock(_inputMutex);
+        _inputQueued.wait_for(lock, timeout, [this]()
+                              { return !_inputQueue.empty(); });
+    }
+
+    void Gamepad::applyInput()
+    {
+        InputEvent event;
+        while (_inputQueue.pop(event))
+        {
+            if (event.pressed)
             {
-                exit(ExitState::MANUAL_STOP);
+                _registers.setStopMode(false);
             }
-            else if (event.type == SDL_DROPFILE)
+
+            if (event.button == NO_BUTTON)
             {
-                // Resetting gambeoy instance and loading new ROM
-                char *droppedFile = event.drop.file;
-                if (droppedFile)
-                {
-                    std::string filePath(droppedFile);
-                    gasyboy::provider::UtilitiesProvider::getInstance()->newRomFilePath = filePath;
-                    gasyboy::provider::UtilitiesProvider::getInstance()->wasReset = true;
-                    SDL_free(droppedFile);
-                }
+                continue;
             }
 
-            else if (event.type == SDL_KEYDOWN)
+            if (event.pressed)
             {
-                provider::RegistersProvider::getInstance()->setStopMode(false);
-
-                switch (event.key.keysym.sym)
-                {
-                case SDLK_ESCAPE:
-                    exit(ExitState::MANUAL_STOP);
-                    break;
-
-                case SDLK_DOLLAR:
-                    gasyboy::provider::UtilitiesProvider::getInstance()->wasRefreshed = true;
-                    break;
-
-                case SDLK_KP_MULTIPLY:
-                case SDLK_ASTERISK:
-                    gasyboy::provider::UtilitiesProvider::getInstance()->wasReset = true;
-                    break;
-
-                case SDLK_UP:
-                    _state.reset(Button::UP);
-                    break;
-                case SDLK_RETURN:
-                    _state.reset(Button::SELECT);
-                    break;
-
-                case SDLK_DOWN:
-                    _state.reset(Button::DOWN);
-                    break;
-                case SDLK_SPACE:
-                    _state.reset(Button::START);
-                    break;
-
-                case SDLK_RIGHT:
-                    _state.reset(Button::RIGHT);
-                    break;
-                case SDLK_a:
-                    _state.reset(Button::A);
-                    break;
-
-                case SDLK_LEFT:
-                    _state.reset(Button::LEFT);
-                    break;
-                case SDLK_z:
-                    _state.reset(Button::B);
-                    break;
-
-                case SDLK_p:
-                    _changedPalette = true;
-                }
+                _state.reset(event.button);
             }
-
-            if (event.type == SDL_KEYUP)
+            else
             {
-                switch (event.key.keysym.sym)
-                {
-                case SDLK_ESCAPE:
-                    exit(0);
-                    break;
-
-                case SDLK_UP:
-                    _state.set(Button::UP);
-                    break;
-                case SDLK_RETURN:
-                    _state.set(Button::SELECT);
-                    break;
-
-                case SDLK_DOWN:
-                    _state.set(Button::DOWN);
-                    break;
-                case SDLK_SPACE:
-                    _state.set(Button::START);
-                    break;
-
-                case SDLK_RIGHT:
-                    _state.set(Button::RIGHT);
-                    break;
-                case SDLK_a:
-                    _state.set(Button::A);
-                    break;
-
-                case SDLK_LEFT:
-                    _state.set(Button::LEFT);
-                    break;
-                case SDLK_z:
-                    _state.set(Button::B);
-                    break;
-                }
+                _state.set(event.button);
             }
         }
-
-        if (provider::UtilitiesProvider::getInstance()->wasReset)
-        {
-            provider::GameBoyProvider::getInstance()->reset();
-            provider::UtilitiesProvider::getInstance()->wasReset = false;
-        }
     }
 
     void Gamepad::setState(uint8_t value)
@@ -163,6 +89,21 @@ namespace gasyboy
         return _buttonSelected ? (static_cast<uint8_t>(_state.to_ulong()) >> 4) : (static_cast<uint8_t>(_state.to_ulong()) << 4) >> 4;
     }
 
+    uint8_t Gamepad::getButtons()
+    {
+        return static_cast<uint8_t>(_state.to_ulong());
+    }
+
+    void Gamepad::setButtons(const uint8_t &buttons)
+    {
+        // Same as applyInput, a press wakes the CPU from STOP
+        if (~buttons & _state.to_ulong())
+        {
+            _registers.setStopMode(false);
+        }
+        _state = buttons;
+    }
+
     void Gamepad::setChangePalette(const bool &value)
     {
         _changedPalette = value;
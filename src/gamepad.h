@@ -1,30 +1,65 @@
 #ifndef _GAMEPAD_H_
 #define _GAMEPAD_H_
 
+#include <atomic>
 #include <bitset>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include "spscQueue.h"
+#include "saveState.h"
 
 namespace gasyboy
 {
+    class Registers;
+
     class Gamepad
     {
+        // Woken up from STOP mode by a key press
+        Registers &_registers;
+
         // To check what type of button the emulator want to check
-        static bool _buttonSelected;
+        bool _buttonSelected;
 
         // The current button state
         std::bitset<8> _state;
 
-        // To change palette color
-        bool _changedPalette;
+        // To change palette color, set by the input handler thread
+        std::atomic<bool> _changedPalette;
+
+        // Joypad change polled by the input handler, applied by the emulation thread
+        struct InputEvent
+        {
+            int8_t button;
+            bool pressed;
+        };
+
+        SpscQueue<InputEvent, 256> _inputQueue;
+
+        // Wakes the emulation thread waiting for a key press in STOP mode
+        std::mutex _inputMutex;
+        std::condition_variable _inputQueued;
 
     public:
         // Constructor
-        Gamepad();
+        Gamepad(Registers &registers);
 
         // Reset
         void reset();
 
-        // Handle key press/release events
-        void handleEvent();
+        // Save state, queued input is not part of it
+        void saveState(StateWriter &writer);
+        void loadState(StateReader &reader);
+
+        // Queue a press/release from the input handler thread, NO_BUTTON only wakes from STOP
+        void queueInput(const int &button, const bool &pressed);
+
+        // Apply queued joypad changes, called at instruction boundaries
+        void applyInput();
+
+        // Block the emulation thread until input is queued or the timeout expires
+        void waitInput(const std::chrono::milliseconds &timeout);
 
         // Set the selected type of button
         void setState(uint8_t value);
@@ -32,6 +67,10 @@ namespace gasyboy
         // Get pressed buttons
         uint8_t getState();
 
+        // All eight buttons, a cleared bit is a pressed button. Used by movies.
+        uint8_t getButtons();
+        void setButtons(const uint8_t &buttons);
+
         // Get/Set palette color if it's changed or not
         void setChangePalette(const bool &value);
         bool getChangePalette();
@@ -49,8 +88,11 @@ namespace gasyboy
             DOWN = 7
         };
 
+        // Key that is not on the joypad, its press still wakes the CPU from STOP
+        static constexpr int NO_BUTTON = -1;
+
         // To check if button or d-pad is selected
-        static bool isButtonSelected();
+        bool isButtonSelected();
     };
 }
 
@@ -0,0 +1,306 @@
+#include "gasyboyApi.h"
+#include "apiError.h"
+#include "gameboy.h"
+#include "nullFrontend.h"
+#include <exception>
+#include <string>
+
+static_assert(sizeof(gasyboy::Colour) == 4, "The framebuffer is handed out as RGBA bytes");
+
+struct gasyboy_instance
+{
+    std::unique_ptr<gasyboy::GameBoy> gameboy;
+
+    // State right after creation, reset() comes back to it without the ROM file
+    std::vector<uint8_t> initialState;
+
+    gasyboy_vblank_callback vblankCallback = nullptr;
+    void *vblankUserData = nullptr;
+};
+
+namespace
+{
+    thread_local std::string lastError;
+
+    int fail(const std::exception &e)
+    {
+        lastError = e.what();
+        return -1;
+    }
+
+    int invalidArgument()
+    {
+        lastError = "invalid argument";
+        return -1;
+    }
+}
+
+void gasyboy::api::setLastError(const std::string &message)
+{
+    lastError = message;
+}
+
+uint32_t gasyboy_api_version(void)
+{
+    return (GASYBOY_API_VERSION_MAJOR << 16) | GASYBOY_API_VERSION_MINOR;
+}
+
+gasyboy_instance *gasyboy_create(const uint8_t *rom, size_t rom_size, uint32_t flags)
+{
+    if (!rom)
+    {
+        invalidArgument();
+        return nullptr;
+    }
+
+    if (rom_size < 0x150)
+    {
+        lastError = "ROM too small to hold a cartridge header";
+        return nullptr;
+    }
+
+    try
+    {
+        auto utilities = std::make_shared<gasyboy::Utilities>();
+        utilities->executeBios = flags & GASYBOY_FLAG_BIOS;
+        utilities->threadedEmulation = false;
+        utilities->threadedPpu = false;
+        utilities->speed = gasyboy::GameBoy::SPEED_UNCAPPED;
+
+        // The first two banks are read without bounds checks, a shorter ROM is padded like unmapped memory
+        std::vector<uint8_t> padded;
+        if (rom_size < 0x8000)
+        {
+            padded.assign(rom, rom + rom_size);
+            padded.resize(0x8000, 0xFF);
+            rom = padded.data();
+            rom_size = padded.size();
+        }
+
+        auto gb = std::make_unique<gasyboy_instance>();
+        gb->gameboy = std::make_unique<gasyboy::GameBoy>(utilities, rom, rom_size,
+                                                         std::make_unique<gasyboy::NullRenderer>(),
+                                                         std::make_unique<gasyboy::NullInputHandler>());
+
+        // The core only logs a ROM it cannot load and comes up without a cartridge
+        const std::string &romError = gb->gameboy->getMmu().getRomLoadError();
+        if (!romError.empty())
+        {
+            lastError = romError;
+            return nullptr;
+        }
+
+        // Serial output is dropped until a callback is set, it would otherwise be logged
+        gb->gameboy->getMmu().setSerialHandler([](const uint8_t &) {});
+
+        gb->initialState.resize(gb->gameboy->saveStateSize());
+        gb->gameboy->saveState(gb->initialState.data(), gb->initialState.size());
+
+        lastError.clear();
+        return gb.release();
+    }
+    catch (const std::exception &e)
+    {
+        fail(e);
+        return nullptr;
+    }
+}
+
+void gasyboy_destroy(gasyboy_instance *gb)
+{
+    delete gb;
+}
+
+int gasyboy_reset(gasyboy_instance *gb)
+{
+    if (!gb)
+    {
+        return invalidArgument();
+    }
+
+    try
+    {
+        gb->gameboy->loadState(gb->initialState.data(), gb->initialState.size());
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        return fail(e);
+    }
+}
+
+int gasyboy_run_frame(gasyboy_instance *gb)
+{
+    if (!gb)
+    {
+        return invalidArgument();
+    }
+
+    try
+    {
+        gb->gameboy->loop();
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        return fail(e);
+    }
+}
+
+int64_t gasyboy_run_cycles(gasyboy_instance *gb, uint64_t cycles)
+{
+    if (!gb)
+    {
+        return invalidArgument();
+    }
+
+    try
+    {
+        return static_cast<int64_t>(gb->gameboy->runCycles(cycles));
+    }
+    catch (const std::exception &e)
+    {
+        return fail(e);
+    }
+}
+
+uint64_t gasyboy_cycle_count(gasyboy_instance *gb)
+{
+    return gb ? gb->gameboy->getCycleCount() : 0;
+}
+
+void gasyboy_set_input(gasyboy_instance *gb, uint8_t buttons)
+{
+    // The joypad clears a bit for a pressed button
+    if (gb)
+    {
+        gb->gameboy->getGamepad().setButtons(static_cast<uint8_t>(~buttons));
+    }
+}
+
+const uint8_t *gasyboy_framebuffer(gasyboy_instance *gb)
+{
+    return gb ? reinterpret_cast<const uint8_t *>(gb->gameboy->getPpu()._framebuffer) : nullptr;
+}
+
+size_t gasyboy_state_size(gasyboy_instance *gb)
+{
+    return gb ? gb->gameboy->saveStateSize() : 0;
+}
+
+int gasyboy_save_state(gasyboy_instance *gb, uint8_t *buffer, size_t capacity)
+{
+    if (!gb || !buffer)
+    {
+        return invalidArgument();
+    }
+
+    try
+    {
+        gb->gameboy->saveState(buffer, capacity);
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        return fail(e);
+    }
+}
+
+int gasyboy_load_state(gasyboy_instance *gb, const uint8_t *buffer, size_t size)
+{
+    if (!gb || !buffer)
+    {
+        return invalidArgument();
+    }
+
+    try
+    {
+        gb->gameboy->loadState(buffer, size);
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        return fail(e);
+    }
+}
+
+uint8_t gasyboy_read_memory(gasyboy_instance *gb, uint16_t address)
+{
+    if (!gb)
+    {
+        invalidArgument();
+        return 0xFF;
+    }
+
+    try
+    {
+        return gb->gameboy->getMmu().readRam(address);
+    }
+    catch (const std::exception &e)
+    {
+        fail(e);
+        return 0xFF;
+    }
+}
+
+void gasyboy_write_memory(gasyboy_instance *gb, uint16_t address, uint8_t value)
+{
+    if (!gb)
+    {
+        invalidArgument();
+        return;
+    }
+
+    try
+    {
+        gb->gameboy->getMmu().writeRam(address, value);
+    }
+    catch (const std::exception &e)
+    {
+        fail(e);
+    }
+}
+
+void gasyboy_set_serial_callback(gasyboy_instance *gb, gasyboy_serial_callback callback, void *user_data)
+{
+    if (!gb)
+    {
+        return;
+    }
+
+    if (callback)
+    {
+        gb->gameboy->getMmu().setSerialHandler([callback, user_data](const uint8_t &value)
+                                               { callback(user_data, value); });
+    }
+    else
+    {
+        gb->gameboy->getMmu().setSerialHandler([](const uint8_t &) {});
+    }
+}
+
+void gasyboy_set_vblank_callback(gasyboy_instance *gb, gasyboy_vblank_callback callback, void *user_data)
+{
+    if (!gb)
+    {
+        return;
+    }
+
+    gb->vblankCallback = callback;
+    gb->vblankUserData = user_data;
+
+    if (callback)
+    {
+        gb->gameboy->getPpu().setVBlankHandler([gb]()
+                                               { gb->vblankCallback(gb->vblankUserData, gasyboy_framebuffer(gb)); });
+    }
+    else
+    {
+        gb->gameboy->getPpu().setVBlankHandler(nullptr);
+    }
+}
+
+const char *gasyboy_last_error(void)
+{
+    return lastError.c_str();
+}
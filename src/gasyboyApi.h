@@ -0,0 +1,106 @@
+#ifndef _GASYBOY_API_H_
+#define _GASYBOY_API_H_
+
+/* C interface of libgasyboy, for embedding the emulator and driving it over FFI.
+   Functions returning int give 0 on success and -1 on failure, gasyboy_last_error() tells why.
+   An instance is not thread safe, but separate instances can run on separate threads. */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* The major version changes on any incompatible change, the minor one when functions are added */
+#define GASYBOY_API_VERSION_MAJOR 1
+#define GASYBOY_API_VERSION_MINOR 0
+
+#if defined(_WIN32) && defined(GASYBOY_SHARED)
+#ifdef GASYBOY_BUILDING_SHARED
+#define GASYBOY_API __declspec(dllexport)
+#else
+#define GASYBOY_API __declspec(dllimport)
+#endif
+#elif defined(__GNUC__)
+#define GASYBOY_API __attribute__((visibility("default")))
+#else
+#define GASYBOY_API
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    typedef struct gasyboy_instance gasyboy_instance;
+
+    /* Run the boot ROM before the cartridge */
+#define GASYBOY_FLAG_BIOS 0x1
+
+#define GASYBOY_SCREEN_WIDTH 160
+#define GASYBOY_SCREEN_HEIGHT 144
+
+    /* Joypad bits, set for a pressed button */
+    enum
+    {
+        GASYBOY_BUTTON_A = 1 << 0,
+        GASYBOY_BUTTON_B = 1 << 1,
+        GASYBOY_BUTTON_SELECT = 1 << 2,
+        GASYBOY_BUTTON_START = 1 << 3,
+        GASYBOY_BUTTON_RIGHT = 1 << 4,
+        GASYBOY_BUTTON_LEFT = 1 << 5,
+        GASYBOY_BUTTON_UP = 1 << 6,
+        GASYBOY_BUTTON_DOWN = 1 << 7
+    };
+
+    typedef void (*gasyboy_serial_callback)(void *user_data, uint8_t byte);
+
+    /* framebuffer is the same pointer gasyboy_framebuffer() returns */
+    typedef void (*gasyboy_vblank_callback)(void *user_data, const uint8_t *framebuffer);
+
+    /* (major << 16) | minor of the library actually loaded */
+    GASYBOY_API uint32_t gasyboy_api_version(void);
+
+    /* The ROM is copied, the buffer can be freed afterwards. Returns NULL on failure. */
+    GASYBOY_API gasyboy_instance *gasyboy_create(const uint8_t *rom, size_t rom_size, uint32_t flags);
+    GASYBOY_API void gasyboy_destroy(gasyboy_instance *gb);
+
+    /* Back to the state right after gasyboy_create() */
+    GASYBOY_API int gasyboy_reset(gasyboy_instance *gb);
+
+    /* Run one frame, 70224 cycles */
+    GASYBOY_API int gasyboy_run_frame(gasyboy_instance *gb);
+
+    /* Run at least this many cycles, up to the end of the instruction reaching them.
+       Returns the cycles actually run, -1 on failure. */
+    GASYBOY_API int64_t gasyboy_run_cycles(gasyboy_instance *gb, uint64_t cycles);
+
+    /* Cycles run since creation or the last reset */
+    GASYBOY_API uint64_t gasyboy_cycle_count(gasyboy_instance *gb);
+
+    /* GASYBOY_BUTTON_* mask, held until changed */
+    GASYBOY_API void gasyboy_set_input(gasyboy_instance *gb, uint8_t buttons);
+
+    /* 160x144 RGBA pixels, row after row. The pointer stays valid for the life of the instance
+       and always shows the current frame, nothing is copied. */
+    GASYBOY_API const uint8_t *gasyboy_framebuffer(gasyboy_instance *gb);
+
+    /* Save states go to and come from a caller-owned buffer of gasyboy_state_size() bytes */
+    GASYBOY_API size_t gasyboy_state_size(gasyboy_instance *gb);
+    GASYBOY_API int gasyboy_save_state(gasyboy_instance *gb, uint8_t *buffer, size_t capacity);
+    GASYBOY_API int gasyboy_load_state(gasyboy_instance *gb, const uint8_t *buffer, size_t size);
+
+    /* Memory as the CPU sees it, writes go through the cartridge and registers like CPU writes.
+       On failure reads return 0xFF and both set the last error. */
+    GASYBOY_API uint8_t gasyboy_read_memory(gasyboy_instance *gb, uint16_t address);
+    GASYBOY_API void gasyboy_write_memory(gasyboy_instance *gb, uint16_t address, uint8_t value);
+
+    /* Called from the emulating thread, a NULL callback removes it */
+    GASYBOY_API void gasyboy_set_serial_callback(gasyboy_instance *gb, gasyboy_serial_callback callback, void *user_data);
+    GASYBOY_API void gasyboy_set_vblank_callback(gasyboy_instance *gb, gasyboy_vblank_callback callback, void *user_data);
+
+    /* Message of the last failure on this thread, empty if none */
+    GASYBOY_API const char *gasyboy_last_error(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,245 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#include "argparse.hpp"
+#include "nullFrontend.h"
+#include "batchRunner.h"
+#include "gbException.h"
+#include "gameboy.h"
+#include "logger.h"
+#include "profiler.h"
+#include "utils.h"
+#include "wavWriter.h"
+
+// Runs the core without display or input for a number of frames, then reports.
+// Nothing here links against SDL, so it runs on servers without X/Wayland.
+int main(int argc, char **argv)
+{
+    argparse::ArgumentParser program("gasyboy_headless");
+
+    program.add_argument("-r", "--rom")
+        .help("Path to the ROM file");
+
+    program.add_argument("-n", "--frames")
+        .help("frames of emulated time to run")
+        .default_value(600)
+        .scan<'i', int>();
+
+    program.add_argument("-s", "--skip_bios")
+        .help("skip BIOS on boot")
+        .default_value(false)
+        .implicit_value(true);
+
+    program.add_argument("-t", "--threaded_ppu")
+        .help("render scanlines on a worker thread")
+        .default_value(false)
+        .implicit_value(true);
+
+    program.add_argument("-a", "--run_ahead")
+        .help("frames emulated ahead of the real one each frame")
+        .default_value(0)
+        .scan<'i', int>();
+
+    program.add_argument("--record")
+        .help("record a movie of the run");
+
+    program.add_argument("--play")
+        .help("replay a movie for its whole length and check its state hashes");
+
+    program.add_argument("--wav")
+        .help("write the sound of the run to a 16 bit stereo WAV file");
+
+    program.add_argument("--sample_rate")
+        .help("sample rate of the WAV file")
+        .default_value(gasyboy::Apu::DEFAULT_SAMPLE_RATE)
+        .scan<'i', int>();
+
+    program.add_argument("--audio_quality")
+        .help("resampling kernel of the sound: low, medium or high")
+        .default_value(std::string("medium"));
+
+    program.add_argument("--exec_stats")
+        .help("count executions and cycles per opcode, ROM bank and address, and write the sorted report there");
+
+    program.add_argument("--profile")
+        .help("write a Chrome trace of where the frame time goes, needs a GASYBOY_PROFILER build");
+
+    program.add_argument("--batch")
+        .help("run the test ROMs listed in a manifest");
+
+    program.add_argument("--report")
+        .help("batch report file, JUnit when it ends with .xml, JSON otherwise")
+        .default_value(std::string(""));
+
+    program.add_argument("-j", "--jobs")
+        .help("test ROMs run at once in batch mode, 0 uses every core")
+        .default_value(0)
+        .scan<'i', int>();
+
+    int frames = 0;
+    gasyboy::BlipBuffer::Quality audioQuality = gasyboy::BlipBuffer::Quality::MEDIUM;
+
+    try
+    {
+        program.parse_args(argc, argv);
+        frames = program.get<int>("--frames");
+
+        if (program.is_used("--batch"))
+        {
+            return gasyboy::BatchRunner::runManifest(program.get<std::string>("--batch"),
+                                                     program.get<std::string>("--report"),
+                                                     program.get<int>("--jobs"));
+        }
+
+        if (!program.is_used("--rom"))
+        {
+            throw std::runtime_error("--rom is required");
+        }
+
+        if (!gasyboy::BlipBuffer::parseQuality(program.get<std::string>("--audio_quality"), audioQuality))
+        {
+            throw std::runtime_error("Invalid audio quality: " + program.get<std::string>("--audio_quality"));
+        }
+
+        if (program.is_used("--profile") && !gasyboy::utils::Profiler::AVAILABLE)
+        {
+            throw std::runtime_error("--profile needs a build with GASYBOY_PROFILER");
+        }
+    }
+    catch (const std::runtime_error &err)
+    {
+        std::cout << err.what() << "\n";
+        std::cout << "usage: gasyboy_headless [-r | --rom rom_file_path] [-n | --frames count]\n"
+                  << "       gasyboy_headless --batch manifest [--report report_file] [-j | --jobs count]\n"
+                  << "\t-r | --rom : the path to the rom file to load\n"
+                  << "\t-n | --frames : frames of emulated time to run (default: 600)\n"
+                  << "\t-s | --skip_bios : skip BIOS on boot (default: false)\n"
+                  << "\t-t | --threaded_ppu : render scanlines on a worker thread (default: false)\n"
+                  << "\t-a | --run_ahead : frames emulated ahead of the real one (default: 0)\n"
+                  << "\t--record : record a movie of the run\n"
+                  << "\t--play : replay a movie, -n is ignored, exits with 1 if it diverges\n"
+                  << "\t--wav : write the sound of the run to a WAV file\n"
+                  << "\t--sample_rate : sample rate of the WAV file (default: 48000)\n"
+                  << "\t--audio_quality : resampling kernel, low, medium or high (default: medium)\n"
+                  << "\t--exec_stats : write executions and cycles per opcode, ROM bank and address to a file\n"
+                  << "\t--profile : write a Chrome trace of the run, GASYBOY_PROFILER builds only\n"
+                  << "\t--batch : run the test ROMs of a manifest, one per line:\n"
+                  << "\t          path [pass=text] [fail=text] [cycles=n] [hash=hex] [bios]\n"
+                  << "\t--report : batch report, JUnit for .xml files, JSON otherwise\n"
+                  << "\t-j | --jobs : test ROMs run at once (default: every core)\n";
+        return 1;
+    }
+    catch (const gasyboy::exception::GbException &e)
+    {
+        std::cout << e.what() << "\n";
+        return 1;
+    }
+
+    auto utilities = std::make_shared<gasyboy::Utilities>();
+    utilities->romFilePath = std::filesystem::path(program.get<std::string>("--rom")).make_preferred().string();
+    utilities->executeBios = !program.get<bool>("--skip_bios");
+    utilities->threadedPpu = program.get<bool>("--threaded_ppu");
+    utilities->runAhead = program.get<int>("--run_ahead");
+    utilities->audioQuality = audioQuality;
+    if (program.is_used("--exec_stats"))
+    {
+        utilities->executionStatsPath = program.get<std::string>("--exec_stats");
+    }
+
+    // Run on this thread as fast as possible
+    utilities->debugMode = false;
+    utilities->threadedEmulation = false;
+    utilities->speed = gasyboy::GameBoy::SPEED_UNCAPPED;
+
+    try
+    {
+        // The core is too big for the stack
+        auto gameboy = std::make_unique<gasyboy::GameBoy>(utilities,
+                                                          std::make_unique<gasyboy::NullRenderer>(),
+                                                          std::make_unique<gasyboy::NullInputHandler>());
+
+        std::unique_ptr<gasyboy::WavWriter> wav;
+        if (program.is_used("--wav"))
+        {
+            auto &apu = gameboy->getApu();
+            apu.setSampleRate(program.get<int>("--sample_rate"));
+            wav = std::make_unique<gasyboy::WavWriter>(program.get<std::string>("--wav"), apu.getSampleRate(), 2);
+            apu.setSampleHandler([&wav](const int16_t *samples, const size_t &frames)
+                                 { wav->write(samples, frames); });
+        }
+
+        if (program.is_used("--play"))
+        {
+            gameboy->playMovie(program.get<std::string>("--play"));
+        }
+        else if (program.is_used("--record"))
+        {
+            gameboy->recordMovie(program.get<std::string>("--record"));
+        }
+
+        if (program.is_used("--profile"))
+        {
+            gasyboy::utils::Profiler::getInstance()->start(program.get<std::string>("--profile"));
+        }
+
+        // A loop() is not a frame: it stops on a cycle count, not at VBlank, and the LCD may be off.
+        // The run is measured in emulated time, and frames are those the PPU completed.
+        auto &ppu = gameboy->getPpu();
+        const uint64_t cycles = static_cast<uint64_t>(std::max(frames, 0)) * MAXCYCLE;
+        const uint64_t startFrames = ppu._frameCount;
+
+        const auto start = std::chrono::steady_clock::now();
+        if (program.is_used("--play"))
+        {
+            while (gameboy->getMovieFrame() < gameboy->getMovieLength())
+            {
+                gameboy->loop();
+            }
+        }
+        else
+        {
+            while (gameboy->getCycleCount() < cycles)
+            {
+                gameboy->loop();
+            }
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const uint64_t completedFrames = ppu._frameCount - startFrames;
+
+        // Flush the render worker so the last frame is complete
+        ppu.setThreadedRendering(false);
+        gasyboy::utils::Profiler::getInstance()->stop();
+        gameboy->writeExecutionStats();
+
+        // Emulation logs come out before the results
+        gasyboy::utils::Logger::getInstance()->flush();
+
+        std::cout << "frames: " << completedFrames << "\n"
+                  << "cycles: " << gameboy->getCycleCount() << "\n"
+                  << "seconds: " << seconds << "\n"
+                  << "frames/s: " << (seconds > 0 ? completedFrames / seconds : 0) << "\n"
+                  << "frame hash: " << std::hex << gasyboy::utils::hash64(ppu._framebuffer, sizeof(ppu._framebuffer)) << std::dec << "\n";
+
+        if (wav)
+        {
+            std::cout << "audio frames: " << wav->getFrames() << "\n";
+        }
+
+        if (program.is_used("--play"))
+        {
+            const int64_t divergence = gameboy->getMovieDivergence();
+            std::cout << "movie: " << (divergence < 0 ? "matched" : "diverged at frame " + std::to_string(divergence)) << "\n";
+            return divergence < 0 ? 0 : 1;
+        }
+    }
+    catch (const gasyboy::exception::GbException &e)
+    {
+        gasyboy::utils::Logger::getInstance()->log(gasyboy::utils::Logger::LogType::CRITICAL, e.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -4,9 +4,9 @@ namespace gasyboy
 {
     void Cpu::CPL()
     {
-        uint8_t value = _registers->AF.getLeftRegister();
-        _registers->AF.setLeftRegister(~value);
-        _registers->AF.setFlag(Register::FlagName::H);
-        _registers->AF.setFlag(Register::FlagName::N);
+        uint8_t value = _registers.AF.getLeftRegister();
+        _registers.AF.setLeftRegister(~value);
+        _registers.AF.setFlag(Register::FlagName::H);
+        _registers.AF.setFlag(Register::FlagName::N);
     }
 }
\ No newline at end of file
@@ -4,7 +4,7 @@ namespace gasyboy
 {
     void Cpu::DI()
     {
-        _registers->setInterruptEnabled(false);
-        _interruptManager->setMasterInterrupt(false);
+        _registers.setInterruptEnabled(false);
+        _interruptManager.setMasterInterrupt(false);
     }
 }
\ No newline at end of file
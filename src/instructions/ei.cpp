@@ -4,7 +4,7 @@ namespace gasyboy
 {
     void Cpu::EI()
     {
-        _registers->setInterruptEnabled(true);
-        _interruptManager->setMasterInterrupt(true);
+        _registers.setInterruptEnabled(true);
+        _interruptManager.setMasterInterrupt(true);
     }
 }
\ No newline at end of file
@@ -8,25 +8,25 @@ namespace gasyboy
         switch (reg)
         {
         case Register::RegisterName::A:
-            value = _registers->AF.getLeftRegister();
+            value = _registers.AF.getLeftRegister();
             break;
         case Register::RegisterName::B:
-            value = _registers->BC.getLeftRegister();
+            value = _registers.BC.getLeftRegister();
             break;
         case Register::RegisterName::C:
-            value = _registers->BC.getRightRegister();
+            value = _registers.BC.getRightRegister();
             break;
         case Register::RegisterName::D:
-            value = _registers->DE.getLeftRegister();
+            value = _registers.DE.getLeftRegister();
             break;
         case Register::RegisterName::E:
-            value = _registers->DE.getRightRegister();
+            value = _registers.DE.getRightRegister();
             break;
         case Register::RegisterName::H:
-            value = _registers->HL.getLeftRegister();
+            value = _registers.HL.getLeftRegister();
             break;
         case Register::RegisterName::L:
-            value = _registers->HL.getRightRegister();
+            value = _registers.HL.getRightRegister();
             break;
         default:
             cout << "Flag error.";
@@ -34,32 +34,32 @@ namespace gasyboy
             break;
         }
 
-        uint8_t result = _registers->AF.getLeftRegister() | value;
-        _registers->AF.setLeftRegister(result);
-        (result == 0) ? _registers->AF.setFlag(Register::FlagName::Z) : _registers->AF.clearFlag(Register::FlagName::Z);
-        _registers->AF.clearFlag(Register::FlagName::H);
-        _registers->AF.clearFlag(Register::FlagName::N);
-        _registers->AF.clearFlag(Register::FlagName::C);
+        uint8_t result = _registers.AF.getLeftRegister() | value;
+        _registers.AF.setLeftRegister(result);
+        (result == 0) ? _registers.AF.setFlag(Register::FlagName::Z) : _registers.AF.clearFlag(Register::FlagName::Z);
+        _registers.AF.clearFlag(Register::FlagName::H);
+        _registers.AF.clearFlag(Register::FlagName::N);
+        _registers.AF.clearFlag(Register::FlagName::C);
     }
 
     void Cpu::OR_n(const uint8_t &value)
     {
-        uint8_t result = _registers->AF.getLeftRegister() | value;
-        _registers->AF.setLeftRegister(result);
-        (result == 0) ? _registers->AF.setFlag(Register::FlagName::Z) : _registers->AF.clearFlag(Register::FlagName::Z);
-        _registers->AF.clearFlag(Register::FlagName::H);
-        _registers->AF.clearFlag(Register::FlagName::N);
-        _registers->AF.clearFlag(Register::FlagName::C);
+        uint8_t result = _registers.AF.getLeftRegister() | value;
+        _registers.AF.setLeftRegister(result);
+        (result == 0) ? _registers.AF.setFlag(Register::FlagName::Z) : _registers.AF.clearFlag(Register::FlagName::Z);
+        _registers.AF.clearFlag(Register::FlagName::H);
+        _registers.AF.clearFlag(Register::FlagName::N);
+        _registers.AF.clearFlag(Register::FlagName::C);
     }
 
     void Cpu::OR_16()
     {
-        uint8_t value = _mmu->readRam(_registers->HL.get());
-        uint8_t result = _registers->AF.getLeftRegister() | value;
-        _registers->AF.setLeftRegister(result);
-        (result == 0) ? _registers->AF.setFlag(Register::FlagName::Z) : _registers->AF.clearFlag(Register::FlagName::Z);
-        _registers->AF.clearFlag(Register::FlagName::H);
-        _registers->AF.clearFlag(Register::FlagName::N);
-        _registers->AF.clearFlag(Register::FlagName::C);
+        uint8_t value = _mmu.readRam(_registers.HL.get());
+        uint8_t result = _registers.AF.getLeftRegister() | value;
+        _registers.AF.setLeftRegister(result);
+        (result == 0) ? _registers.AF.setFlag(Register::FlagName::Z) : _registers.AF.clearFlag(Register::FlagName::Z);
+        _registers.AF.clearFlag(Register::FlagName::H);
+        _registers.AF.clearFlag(Register::FlagName::N);
+        _registers.AF.clearFlag(Register::FlagName::C);
     }
 }
\ No newline at end of file
@@ -4,10 +4,10 @@ namespace gasyboy
 {
     void Cpu::SCF()
     {
-        uint8_t value = _registers->AF.getRightRegister();
+        uint8_t value = _registers.AF.getRightRegister();
         value |= 0x10;
-        _registers->AF.setRightRegister(value);
-        _registers->AF.clearFlag(Register::FlagName::N);
-        _registers->AF.clearFlag(Register::FlagName::H);
+        _registers.AF.setRightRegister(value);
+        _registers.AF.clearFlag(Register::FlagName::N);
+        _registers.AF.clearFlag(Register::FlagName::H);
     }
 }
\ No newline at end of file
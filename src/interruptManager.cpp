@@ -1,82 +1,64 @@
-#include "registersProvider.h"
 #include "interruptManager.h"
-#include "mmuProvider.h"
-#include "mmuProvider.h"
+#include <bit>
 
 namespace gasyboy
 {
-    InterruptManager::InterruptManager()
-        : _mmu(provider::MmuProvider::getInstance()),
-          _registers(provider::RegistersProvider::getInstance()),
-          _masterInterrupt(false)
+    InterruptManager::InterruptManager(Mmu &mmu, Registers &registers)
+        : _masterInterrupt(false),
+          _mmu(mmu),
+          _registers(registers),
+          _interruptFlags(0),
+          _interruptEnable(0),
+          _pending(0)
     {
-        _interruptAddressMap = {
-            {InterruptType::VBlank, InterruptAddress::VBlank},
-            {InterruptType::LCDStat, InterruptAddress::LCDStat},
-            {InterruptType::Timer, InterruptAddress::Timer},
-            {InterruptType::Serial, InterruptAddress::Serial}};
     }
 
     InterruptManager &InterruptManager::operator=(const InterruptManager &other)
     {
-        _mmu = provider::MmuProvider::getInstance();             // Reacquire MMU instance
-        _registers = provider::RegistersProvider::getInstance(); // Reacquire Registers
-        _masterInterrupt = false;                                // Reset interrupt state
+        _masterInterrupt = false; // Reset interrupt state
 
-        // Reinitialize the interrupt address map
-        _interruptAddressMap = {
-            {InterruptType::VBlank, InterruptAddress::VBlank},
-            {InterruptType::LCDStat, InterruptAddress::LCDStat},
-            {InterruptType::Timer, InterruptAddress::Timer},
-            {InterruptType::Serial, InterruptAddress::Serial}};
+        _interruptFlags = other._interruptFlags;
+        _interruptEnable = other._interruptEnable;
+        updatePending();
 
         std::cout << "InterruptManager reset complete.\n";
         return *this;
     }
 
-    void InterruptManager::handleInterrupts()
+    void InterruptManager::updatePending()
     {
-        if (!_masterInterrupt)
-            return; // Ensure master interrupt is enabled
+        _pending = _interruptFlags & _interruptEnable & 0x1F;
+    }
 
-        if (_registers->getInterruptEnabled())
+    void InterruptManager::servicePending()
+    {
+        // Lowest bit first, the CPU only handles one interrupt at a time
+        if (_registers.getInterruptEnabled())
         {
-            uint8_t req = _mmu->readRam(0xFF0F);
-            uint8_t enable = _mmu->readRam(0xFFFF);
-
-            for (int i = 0; i < 5; i++)
-            {
-                if ((req & (1 << i)) && (enable & (1 << i))) // Check request & enable bit
-                {
-                    serviceInterrupt(static_cast<InterruptType>(i));
-                    break; // The CPU only handles one interrupt at a time
-                }
-            }
+            serviceInterrupt(static_cast<InterruptType>(std::countr_zero(_pending)));
         }
     }
 
     void InterruptManager::requestInterrupt(const InterruptType &interrupt)
     {
-        uint8_t req = _mmu->readRam(0xFF0F);
-        req |= (1 << static_cast<uint8_t>(interrupt));
-        _mmu->writeRam(0xFF0F, req);
+        _interruptFlags |= (1 << static_cast<uint8_t>(interrupt));
+        updatePending();
     }
 
     void InterruptManager::serviceInterrupt(const InterruptType &interrupt)
     {
-        if (!_registers->getInterruptEnabled())
+        if (!_registers.getInterruptEnabled())
             return;
 
         _masterInterrupt = false;
 
-        uint8_t req = _mmu->readRam(0xFF0F);
-        req &= ~(1 << static_cast<uint8_t>(interrupt));
-        _mmu->writeRam(0xFF0F, req);
+        _interruptFlags &= ~(1 << static_cast<uint8_t>(interrupt));
+        updatePending();
 
-        _registers->pushSP(_registers->PC); // Save current PC
-        _registers->setHalted(false);       // Wake up CPU
+        _registers.pushSP(_registers.PC); // Save current PC
+        _registers.setHalted(false);       // Wake up CPU
 
-        _registers->PC = static_cast<uint16_t>(_interruptAddressMap[interrupt]);
+        _registers.PC = static_cast<uint16_t>(INTERRUPT_ADDRESSES[static_cast<size_t>(interrupt)]);
     }
 
     bool InterruptManager::isMasterInterruptEnabled()
@@ -89,8 +71,48 @@ namespace gasyboy
         _masterInterrupt = value;
     }
 
+    uint8_t InterruptManager::IF()
+    {
+        return _interruptFlags;
+    }
+
+    uint8_t InterruptManager::IE()
+    {
+        return _interruptEnable;
+    }
+
+    void InterruptManager::setIF(const uint8_t &value)
+    {
+        _interruptFlags = value;
+        updatePending();
+    }
+
+    void InterruptManager::setIE(const uint8_t &value)
+    {
+        _interruptEnable = value;
+        updatePending();
+    }
+
     void InterruptManager::reset()
     {
         _masterInterrupt = false;
+        _interruptFlags = 0;
+        _interruptEnable = 0xFF;
+        updatePending();
+    }
+
+    void InterruptManager::saveState(StateWriter &writer)
+    {
+        writer.writeBool(_masterInterrupt);
+        writer.write8(_interruptFlags);
+        writer.write8(_interruptEnable);
+    }
+
+    void InterruptManager::loadState(StateReader &reader)
+    {
+        _masterInterrupt = reader.readBool();
+        _interruptFlags = reader.read8();
+        _interruptEnable = reader.read8();
+        updatePending();
     }
-}
\ No newline at end of file
+}
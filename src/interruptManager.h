@@ -3,18 +3,31 @@
 
 #include "registers.h"
 #include "mmu.h"
-#include <map>
+#include "profiler.h"
+#include <array>
 
 namespace gasyboy
 {
     class InterruptManager
     {
         bool _masterInterrupt;
-        std::shared_ptr<Mmu> _mmu;
-        std::shared_ptr<Registers> _registers;
+        Mmu &_mmu;
+        Registers &_registers;
+
+        // IF and IE, the MMU reads and writes them here
+        uint8_t _interruptFlags;
+        uint8_t _interruptEnable;
+
+        // IF & IE & 0x1F, updated whenever either changes so the check before each instruction is one byte
+        uint8_t _pending;
+
+        void updatePending();
+
+        // Service the highest priority pending interrupt
+        void servicePending();
 
     public:
-        InterruptManager();
+        InterruptManager(Mmu &mmu, Registers &registers);
         InterruptManager &operator=(const InterruptManager &);
         ~InterruptManager() = default;
 
@@ -32,10 +45,33 @@ namespace gasyboy
             VBlank = 0x40,  // V-Blank Interrupt
             LCDStat = 0x48, // LCD Status Interrupt
             Timer = 0x50,   // Timer Interrupt
-            Serial = 0x60   // Serial Interrupt
+            Serial = 0x58,  // Serial Interrupt
+            Joypad = 0x60   // Joypad Interrupt
         };
 
-        void handleInterrupts();
+        // Vector of each interrupt type, by bit number
+        static constexpr std::array<InterruptAddress, 5> INTERRUPT_ADDRESSES = {
+            InterruptAddress::VBlank,
+            InterruptAddress::LCDStat,
+            InterruptAddress::Timer,
+            InterruptAddress::Serial,
+            InterruptAddress::Joypad};
+
+        // Called before every instruction, inline so that nothing pending costs a byte test
+        void handleInterrupts()
+        {
+            if (_pending && _masterInterrupt)
+            {
+                // Timed only when something is serviced, the test alone is cheaper than the timer
+                GASYBOY_PROFILE_SCOPE("InterruptManager::handleInterrupts");
+                servicePending();
+            }
+        }
+
+        bool hasPendingInterrupt()
+        {
+            return _pending != 0;
+        }
 
         void requestInterrupt(const InterruptType &interrupt);
 
@@ -45,11 +81,17 @@ namespace gasyboy
 
         void setMasterInterrupt(const bool &value);
 
+        uint8_t IF();
+        uint8_t IE();
+        void setIF(const uint8_t &value);
+        void setIE(const uint8_t &value);
+
         void reset();
 
-    private:
-        std::map<InterruptType, InterruptAddress> _interruptAddressMap;
+        // Save state
+        void saveState(StateWriter &writer);
+        void loadState(StateReader &reader);
     };
 }
 
-#endif
\ No newline at end of file
+#endif
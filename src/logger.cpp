@@ -1,3 +1,5 @@
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include "logger.h"
 
@@ -5,56 +7,273 @@ namespace gasyboy
 {
     namespace utils
     {
-        std::shared_ptr<Logger> Logger::_instance = nullptr;
-        std::stringstream gasyboy::utils::Logger::_log;
-        std::stringstream gasyboy::utils::Logger::_serialDebugLog;
+        namespace
+        {
+            // How long the background thread sleeps when there is nothing to write
+            constexpr auto IDLE_WAIT = std::chrono::milliseconds(2);
+
+            const char *prefix(const Logger::LogType &type)
+            {
+                switch (type)
+                {
+                case Logger::LogType::CRITICAL:
+                    return "[CRITICAL] - ";
+                case Logger::LogType::DEBUG:
+                    return "[DEBUG] - ";
+                case Logger::LogType::FUNCTIONAL:
+                    return "[FUNCTIONAL] - ";
+                case Logger::LogType::INFO:
+                    return "[INFO] - ";
+                default:
+                    return "[SERIAL] - ";
+                }
+            }
+        }
 
         Logger::Logger()
+            : _tail(0),
+              _head(0),
+              _dropped(0),
+              _running(false),
+              _reportedDrops(0)
         {
-            clear();
-            _logTypeMap = {{LogType::CRITICAL, "[CRITICAL] - "},
-                           {LogType::DEBUG, "[DEBUG] - "},
-                           {LogType::FUNCTIONAL, "[FUNCTIONAL] - "},
-                           {LogType::INFO, "[INFO] - "}};
+            for (size_t i = 0; i < RING_SLOTS; i++)
+            {
+                _slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+
+#ifndef EMSCRIPTEN
+            _running = true;
+            _thread = std::thread(&Logger::drainLoop, this);
+#endif
         }
 
-        std::shared_ptr<Logger> Logger::getInstance()
+        Logger *Logger::getInstance()
         {
-            if (!_instance)
+            // Never destroyed, objects logging from their own destructors at exit stay safe
+            static Logger *instance = []
             {
-                _instance = std::shared_ptr<Logger>(new Logger());
-            }
-            return _instance;
+                auto *logger = new Logger();
+                std::atexit([]
+                            { getInstance()->shutdown(); });
+                return logger;
+            }();
+            return instance;
         }
 
         void Logger::log(const LogType &type, const std::string &message)
         {
-            std::stringstream currentLog;
-            currentLog << _logTypeMap[type] << message << std::endl;
-            if (type == LogType::SERIAL_DEBUG)
+            if (enabled(type))
             {
-                _log << _serialDebugLog.str();
-                currentLog << _serialDebugLog.str();
+                push(type, message);
             }
+        }
+
+        void Logger::pushRecord(const LogType &type, const Formatter &format, const uint8_t *record, const size_t &size)
+        {
+            const size_t count = std::max<size_t>(1, (size + PAYLOAD_SIZE - 1) / PAYLOAD_SIZE);
 
-            _log << currentLog.str();
-            std::cout << currentLog.str();
+            // The consumer frees slots in order, so the last one being free means all of them are
+            size_t position = _tail.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                const size_t last = position + count - 1;
+                const size_t sequence = _slots[last % RING_SLOTS].sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<std::ptrdiff_t>(sequence - last);
+                if (difference == 0)
+                {
+                    if (_tail.compare_exchange_weak(position, position + count, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    _dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                else
+                {
+                    position = _tail.load(std::memory_order_relaxed);
+                }
+            }
+
+            Slot &first = _slots[position % RING_SLOTS];
+            first.format = format;
+            first.size = static_cast<uint32_t>(size);
+            first.slots = static_cast<uint8_t>(count);
+            first.type = type;
+
+            for (size_t i = 0; i < count; i++)
+            {
+                const size_t offset = i * PAYLOAD_SIZE;
+                std::memcpy(_slots[(position + i) % RING_SLOTS].payload, record + offset, std::min(PAYLOAD_SIZE, size - std::min(size, offset)));
+            }
+
+            // The first slot goes last, once the consumer sees it the whole record is there
+            for (size_t i = count; i-- > 0;)
+            {
+                _slots[(position + i) % RING_SLOTS].sequence.store(position + i + 1, std::memory_order_release);
+            }
+
+            if (!_running.load(std::memory_order_acquire))
+            {
+                std::lock_guard<std::mutex> lock(_drainMutex);
+                drain();
+            }
         }
 
-        void Logger::clear()
+        bool Logger::drain()
+        {
+            bool wrote = false;
+            size_t position = _head.load(std::memory_order_relaxed);
+
+            for (;;)
+            {
+                Slot &first = _slots[position % RING_SLOTS];
+                if (first.sequence.load(std::memory_order_acquire) != position + 1)
+                {
+                    break;
+                }
+
+                const size_t count = first.slots;
+                _payload.clear();
+                for (size_t i = 0; i < count; i++)
+                {
+                    const size_t offset = i * PAYLOAD_SIZE;
+                    _payload.append(reinterpret_cast<const char *>(_slots[(position + i) % RING_SLOTS].payload),
+                                    std::min(PAYLOAD_SIZE, first.size - std::min<size_t>(first.size, offset)));
+                }
+                write(first, _payload);
+
+                for (size_t i = 0; i < count; i++)
+                {
+                    _slots[(position + i) % RING_SLOTS].sequence.store(position + i + RING_SLOTS, std::memory_order_release);
+                }
+                position += count;
+                _head.store(position, std::memory_order_release);
+                wrote = true;
+            }
+
+            const uint64_t dropped = _dropped.load(std::memory_order_relaxed);
+            if (dropped != _reportedDrops)
+            {
+                std::cout << prefix(LogType::INFO) << (dropped - _reportedDrops) << " log records dropped, the ring was full\n";
+                _reportedDrops = dropped;
+            }
+
+            if (wrote)
+            {
+                std::cout.flush();
+            }
+            return wrote;
+        }
+
+        void Logger::drainLoop()
+        {
+            while (_running.load(std::memory_order_acquire))
+            {
+                bool wrote;
+                {
+                    std::lock_guard<std::mutex> lock(_drainMutex);
+                    wrote = drain();
+                }
+                if (!wrote)
+                {
+                    std::this_thread::sleep_for(IDLE_WAIT);
+                }
+            }
+        }
+
+        void Logger::write(const Slot &first, const std::string &payload)
         {
-            _log.str("");
-            _log.clear();
+            _line.clear();
+            first.format(_line, reinterpret_cast<const uint8_t *>(payload.data()));
+
+            if (first.type != LogType::SERIAL_DEBUG)
+            {
+                _line.insert(0, prefix(first.type));
+                writeLine(_line);
+                return;
+            }
+
+            // Serial output comes a character at a time, it is written a line at a time
+            for (const char c : _line)
+            {
+                if (c == '\n')
+                {
+                    writeLine(prefix(LogType::SERIAL_DEBUG) + _serialLine);
+                    _serialLine.clear();
+                }
+                else
+                {
+                    _serialLine += c;
+                }
+            }
         }
 
-        void Logger::deleteInstance()
+        void Logger::writeLine(const std::string &line)
         {
-            _instance.reset();
+            std::cout << line << '\n';
+
+            std::lock_guard<std::mutex> lock(_historyMutex);
+            _history.push_back(line);
+            if (_history.size() > HISTORY_LINES)
+            {
+                _history.pop_front();
+            }
+        }
+
+        void Logger::flush()
+        {
+            const size_t tail = _tail.load(std::memory_order_acquire);
+            while (_head.load(std::memory_order_acquire) < tail)
+            {
+                if (!_running.load(std::memory_order_acquire))
+                {
+                    std::lock_guard<std::mutex> lock(_drainMutex);
+                    drain();
+                    return;
+                }
+                std::this_thread::sleep_for(IDLE_WAIT);
+            }
+        }
+
+        void Logger::shutdown()
+        {
+            if (_running.exchange(false))
+            {
+                // exit() may be called from a thread that logs, never join from the writer itself
+                if (std::this_thread::get_id() == _thread.get_id())
+                {
+                    _thread.detach();
+                }
+                else
+                {
+                    _thread.join();
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(_drainMutex);
+            drain();
+        }
+
+        void Logger::clear()
+        {
+            std::lock_guard<std::mutex> lock(_historyMutex);
+            _history.clear();
         }
 
         std::string Logger::getLogContent()
         {
-            return _log.str();
+            std::lock_guard<std::mutex> lock(_historyMutex);
+            std::string content;
+            for (const auto &line : _history)
+            {
+                content += line;
+                content += '\n';
+            }
+            return content;
         }
     }
 }
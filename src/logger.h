@@ -1,27 +1,40 @@
 #ifndef _LOGGER_H_
 #define _LOGGER_H_
 
-#include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
 #include <string>
-#include <memory>
-#include <map>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+// Lowest level compiled in: 0 debug, 1 info, 2 functional, 3 critical.
+// Debug and serial records vanish from release builds unless set otherwise.
+#ifndef GASYBOY_LOG_LEVEL
+#ifdef NDEBUG
+#define GASYBOY_LOG_LEVEL 1
+#else
+#define GASYBOY_LOG_LEVEL 0
+#endif
+#endif
 
 namespace gasyboy
 {
     namespace utils
     {
+        // Records go into a bounded lock-free ring and are formatted and written by a background thread,
+        // logging never blocks the caller. Arguments are stored as they are, numbers are only turned into
+        // text on the background thread. When the ring is full records are dropped and counted.
         class Logger
         {
-            static std::stringstream _log;
-            static std::stringstream _serialDebugLog;
-            static std::shared_ptr<Logger> _instance;
-            Logger();
-
         public:
-            ~Logger() = default;
-
             // Type of log
-            enum class LogType
+            enum class LogType : uint8_t
             {
                 FUNCTIONAL,
                 DEBUG,
@@ -30,25 +43,213 @@ namespace gasyboy
                 SERIAL_DEBUG
             };
 
-            // Get logger instance
-            static std::shared_ptr<Logger> getInstance();
+            // Slots of the ring and their size, a record longer than one slot takes several in a row
+            static constexpr size_t RING_SLOTS = 2048;
+            static constexpr size_t SLOT_SIZE = 128;
+            static constexpr size_t MAX_RECORD_SLOTS = 32;
+
+            // Lines kept for getLogContent()
+            static constexpr size_t HISTORY_LINES = 1000;
 
-            // Add message to log
+            // Get logger instance, it lives until the process exits
+            static Logger *getInstance();
+
+            static constexpr bool enabled(const LogType &type)
+            {
+                return severity(type) >= GASYBOY_LOG_LEVEL;
+            }
+
+            // Add message to log, filtered at compile time and formatted on the background thread.
+            // Arguments are text, numbers, chars or booleans, written one after the other.
+            template <LogType Type, typename... Args>
+            void log(const Args &...args)
+            {
+                if constexpr (enabled(Type))
+                {
+                    push(Type, args...);
+                }
+            }
+
+            // Add a message whose type is only known at run time
             void log(const LogType &type, const std::string &message);
 
+            // Wait until everything logged so far is written, not for the emulation thread
+            void flush();
+
+            // Write what is left and stop the background thread, records are written synchronously afterwards.
+            // Runs at exit.
+            void shutdown();
+
             // Clear log
             void clear();
 
-            // Delete log instance
-            static void deleteInstance();
-
-            // Get log content
+            // Get the last HISTORY_LINES lines
             std::string getLogContent();
 
         private:
-            std::map<LogType, std::string> _logTypeMap;
+            Logger();
+            ~Logger() = default;
+
+            // Turns the stored arguments of a record into text
+            using Formatter = void (*)(std::string &out, const uint8_t *data);
+
+            struct alignas(64) Slot
+            {
+                // Vyukov's bounded queue: the position the slot is free for, or that position + 1 once written
+                std::atomic<size_t> sequence;
+
+                // Set in the first slot of a record only
+                Formatter format;
+                uint32_t size;
+                uint8_t slots;
+                LogType type;
+
+                uint8_t payload[SLOT_SIZE - sizeof(std::atomic<size_t>) - sizeof(Formatter) - sizeof(uint32_t) - sizeof(uint8_t) - sizeof(LogType)];
+            };
+            static_assert(sizeof(Slot) == SLOT_SIZE, "a slot is two cache lines");
+
+            static constexpr size_t PAYLOAD_SIZE = sizeof(Slot::payload);
+            static constexpr size_t MAX_RECORD_SIZE = PAYLOAD_SIZE * MAX_RECORD_SLOTS;
+
+            static constexpr int severity(const LogType &type)
+            {
+                switch (type)
+                {
+                case LogType::DEBUG:
+                case LogType::SERIAL_DEBUG:
+                    return 0;
+                case LogType::INFO:
+                    return 1;
+                case LogType::FUNCTIONAL:
+                    return 2;
+                default:
+                    return 3;
+                }
+            }
+
+            // Arguments are stored as text views or as the plain values
+            template <typename T>
+            static constexpr bool IS_TEXT = std::is_convertible_v<const T &, std::string_view>;
+
+            template <typename T>
+            using Stored = std::conditional_t<IS_TEXT<T>, std::string_view, std::decay_t<T>>;
+
+            template <typename T>
+            static size_t encodedSize(const T &value)
+            {
+                if constexpr (IS_TEXT<T>)
+                {
+                    return sizeof(uint32_t) + std::string_view(value).size();
+                }
+                else
+                {
+                    static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "log arguments are text, numbers, chars or booleans");
+                    return sizeof(T);
+                }
+            }
+
+            template <typename T>
+            static void encode(uint8_t *&out, const T &value, const size_t &maxText)
+            {
+                if constexpr (IS_TEXT<T>)
+                {
+                    const std::string_view text(value);
+                    const uint32_t length = static_cast<uint32_t>(std::min(text.size(), maxText));
+                    std::memcpy(out, &length, sizeof(length));
+                    std::memcpy(out + sizeof(length), text.data(), length);
+                    out += sizeof(length) + length;
+                }
+                else
+                {
+                    std::memcpy(out, &value, sizeof(T));
+                    out += sizeof(T);
+                }
+            }
+
+            template <typename T>
+            static void decode(std::string &out, const uint8_t *&data)
+            {
+                if constexpr (std::is_same_v<T, std::string_view>)
+                {
+                    uint32_t length;
+                    std::memcpy(&length, data, sizeof(length));
+                    out.append(reinterpret_cast<const char *>(data + sizeof(length)), length);
+                    data += sizeof(length) + length;
+                }
+                else
+                {
+                    T value;
+                    std::memcpy(&value, data, sizeof(T));
+                    data += sizeof(T);
+
+                    if constexpr (std::is_same_v<T, bool>)
+                        out += value ? "true" : "false";
+                    else if constexpr (std::is_same_v<T, char>)
+                        out += value;
+                    else if constexpr (std::is_enum_v<T>)
+                        out += std::to_string(static_cast<std::underlying_type_t<T>>(value));
+                    else
+                        out += std::to_string(value);
+                }
+            }
+
+            template <typename... Stored>
+            static void format(std::string &out, const uint8_t *data)
+            {
+                (decode<Stored>(out, data), ...);
+            }
+
+            // Encode the arguments on the stack, texts are cut when the record would be too long
+            template <typename... Args>
+            void push(const LogType &type, const Args &...args)
+            {
+                uint8_t record[MAX_RECORD_SIZE];
+
+                size_t maxText = MAX_RECORD_SIZE;
+                const size_t size = (encodedSize(args) + ... + 0);
+                if (size > MAX_RECORD_SIZE)
+                {
+                    constexpr size_t texts = ((IS_TEXT<Args> ? 1 : 0) + ... + 0);
+                    const size_t fixed = ((IS_TEXT<Args> ? sizeof(uint32_t) : encodedSize(args)) + ... + 0);
+                    maxText = texts > 0 && fixed < MAX_RECORD_SIZE ? (MAX_RECORD_SIZE - fixed) / std::max<size_t>(texts, 1) : 0;
+                }
+
+                uint8_t *out = record;
+                (encode(out, args, maxText), ...);
+                pushRecord(type, &format<Stored<Args>...>, record, static_cast<size_t>(out - record));
+            }
+
+            // Claim consecutive slots and publish the record, dropped when the ring is full
+            void pushRecord(const LogType &type, const Formatter &format, const uint8_t *record, const size_t &size);
+
+            // Write every complete record, returns false when the ring was empty
+            bool drain();
+            void drainLoop();
+
+            // Format one record and write it out
+            void write(const Slot &first, const std::string &payload);
+            void writeLine(const std::string &line);
+
+            Slot _slots[RING_SLOTS];
+            std::atomic<size_t> _tail;
+            std::atomic<size_t> _head;
+            std::atomic<uint64_t> _dropped;
+
+            // Background writer, or synchronous writes under the mutex when there is none
+            std::thread _thread;
+            std::atomic<bool> _running;
+            std::mutex _drainMutex;
+
+            // Drain side only
+            std::string _payload;
+            std::string _line;
+            std::string _serialLine;
+            uint64_t _reportedDrops;
+
+            std::mutex _historyMutex;
+            std::deque<std::string> _history;
         };
     }
 }
 
-#endif
\ No newline at end of file
+#endif
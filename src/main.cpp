@@ -5,17 +5,17 @@
 
 #include "argparse.hpp"
 #include "gameboy.h"
+#include "batchRunner.h"
+#include "gbException.h"
+#ifndef EMSCRIPTEN
+// SDL2main wraps main()
+#include "SDL.h"
+#endif
 #include "logger.h"
+#include "profiler.h"
 
-#include "interruptManagerProvider.h"
-#include "registersProvider.h"
 #include "utilitiesProvider.h"
-#include "gamepadProvider.h"
 #include "gameBoyProvider.h"
-#include "timerProvider.h"
-#include "mmuProvider.h"
-#include "cpuProvider.h"
-#include "ppuProvider.h"
 
 #ifdef EMSCRIPTEN
 #include <emscripten.h>
@@ -68,7 +68,6 @@ int main(int argc, char **argv)
 
     program.add_argument("-r", "--rom")
         .help("Path to the ROM file")
-        .required()
         .action([](const std::string &value)
                 { return value; });
 
@@ -82,12 +81,132 @@ int main(int argc, char **argv)
         .default_value(false)
         .implicit_value(true);
 
+    program.add_argument("-t", "--threaded_ppu")
+        .help("render scanlines on a worker thread")
+        .default_value(false)
+        .implicit_value(true);
+
+    program.add_argument("-v", "--vsync")
+        .help("present on vsync, frame pacing is dropped when the display runs at the Game Boy rate")
+        .default_value(false)
+        .implicit_value(true);
+
+    program.add_argument("--audio_sync")
+        .help("pace emulation by the audio device instead of a timer, bending the sample rate by up to 0.5% to hold the latency")
+        .default_value(false)
+        .implicit_value(true);
+
+    program.add_argument("--audio_quality")
+        .help("resampling kernel of the sound: low, medium or high")
+        .default_value(std::string("medium"));
+
+    program.add_argument("-f", "--frame_stats")
+        .help("log frame time jitter every second")
+        .default_value(false)
+        .implicit_value(true);
+
+    program.add_argument("-x", "--speed")
+        .help("emulation speed: 1, 2, 4 or uncapped, Tab cycles it while running")
+        .default_value(std::string("1"));
+
+    program.add_argument("-w", "--rewind")
+        .help("seconds of rewind history, Backspace rewinds while held, 0 disables it")
+        .default_value(60)
+        .scan<'i', int>();
+
+    program.add_argument("-a", "--run_ahead")
+        .help("frames emulated ahead and presented to hide the game's input lag, the cost is logged with --frame_stats")
+        .default_value(0)
+        .scan<'i', int>();
+
+    program.add_argument("--record")
+        .help("record the joypad into a movie file, from power-on");
+
+    program.add_argument("--play")
+        .help("replay a movie file recorded with --record");
+
+    program.add_argument("--exec_stats")
+        .help("count executions and cycles per opcode, ROM bank and address, written sorted to this file on exit");
+
+    program.add_argument("--profile")
+        .help("write a Chrome trace of where the frame time goes on exit, needs a GASYBOY_PROFILER build");
+
+    program.add_argument("--single_thread")
+        .help("run emulation on the main thread (always the case in debug mode)")
+        .default_value(false)
+        .implicit_value(true);
+
+    program.add_argument("--batch")
+        .help("run the test ROMs listed in a manifest without display and exit");
+
+    program.add_argument("--report")
+        .help("batch report file, JUnit when it ends with .xml, JSON otherwise")
+        .default_value(std::string(""));
+
+    program.add_argument("-j", "--jobs")
+        .help("test ROMs run at once in batch mode, 0 uses every core")
+        .default_value(0)
+        .scan<'i', int>();
+
     try
     {
         program.parse_args(argc, argv);
+
+        if (program.is_used("--batch"))
+        {
+            return gasyboy::BatchRunner::runManifest(program.get<std::string>("--batch"),
+                                                     program.get<std::string>("--report"),
+                                                     program.get<int>("--jobs"));
+        }
+
+        if (!program.is_used("--rom"))
+        {
+            throw std::runtime_error("--rom is required");
+        }
+
         gasyboy::provider::UtilitiesProvider::getInstance()->romFilePath = std::filesystem::path(program.get<std::string>("--rom")).make_preferred().string();
         gasyboy::provider::UtilitiesProvider::getInstance()->executeBios = !program.get<bool>("--skip_bios");
         gasyboy::provider::UtilitiesProvider::getInstance()->debugMode = program.get<bool>("--debug");
+        gasyboy::provider::UtilitiesProvider::getInstance()->threadedPpu = program.get<bool>("--threaded_ppu");
+        gasyboy::provider::UtilitiesProvider::getInstance()->vsync = program.get<bool>("--vsync");
+        gasyboy::provider::UtilitiesProvider::getInstance()->audioSync = program.get<bool>("--audio_sync");
+        gasyboy::provider::UtilitiesProvider::getInstance()->frameStats = program.get<bool>("--frame_stats");
+        gasyboy::provider::UtilitiesProvider::getInstance()->threadedEmulation = !program.get<bool>("--single_thread");
+        gasyboy::provider::UtilitiesProvider::getInstance()->rewindSeconds = program.get<int>("--rewind");
+        gasyboy::provider::UtilitiesProvider::getInstance()->runAhead = program.get<int>("--run_ahead");
+        if (program.is_used("--exec_stats"))
+        {
+            gasyboy::provider::UtilitiesProvider::getInstance()->executionStatsPath = program.get<std::string>("--exec_stats");
+        }
+
+        const std::string audioQuality = program.get<std::string>("--audio_quality");
+        if (!gasyboy::BlipBuffer::parseQuality(audioQuality, gasyboy::provider::UtilitiesProvider::getInstance()->audioQuality))
+        {
+            throw std::runtime_error("Invalid audio quality: " + audioQuality);
+        }
+
+        const std::string speed = program.get<std::string>("--speed");
+        if (speed == "uncapped")
+        {
+            gasyboy::provider::UtilitiesProvider::getInstance()->speed = gasyboy::GameBoy::SPEED_UNCAPPED;
+        }
+        else if (speed == "1" || speed == "2" || speed == "4")
+        {
+            gasyboy::provider::UtilitiesProvider::getInstance()->speed = std::stoi(speed);
+        }
+        else
+        {
+            throw std::runtime_error("Invalid speed: " + speed);
+        }
+
+        if (program.is_used("--profile"))
+        {
+            if (!gasyboy::utils::Profiler::AVAILABLE)
+            {
+                throw std::runtime_error("--profile needs a build with GASYBOY_PROFILER");
+            }
+            gasyboy::utils::Profiler::getInstance()->start(program.get<std::string>("--profile"));
+        }
 
         auto logger = gasyboy::utils::Logger::getInstance();
         logger->log(gasyboy::utils::Logger::LogType::FUNCTIONAL,
@@ -95,18 +214,63 @@ int main(int argc, char **argv)
                         "\n\t - Use BIOS: " +
                         (gasyboy::provider::UtilitiesProvider::getInstance()->executeBios ? "true" : "false") +
                         "\n\t - Debug Mode: " +
-                        (gasyboy::provider::UtilitiesProvider::getInstance()->debugMode ? "true" : "false"));
+                        (gasyboy::provider::UtilitiesProvider::getInstance()->debugMode ? "true" : "false") +
+                        "\n\t - Threaded PPU: " +
+                        (gasyboy::provider::UtilitiesProvider::getInstance()->threadedPpu ? "true" : "false") +
+                        "\n\t - VSync: " +
+                        (gasyboy::provider::UtilitiesProvider::getInstance()->vsync ? "true" : "false") +
+                        "\n\t - Audio Sync: " +
+                        (gasyboy::provider::UtilitiesProvider::getInstance()->audioSync ? "true" : "false") +
+                        "\n\t - Audio Quality: " + audioQuality +
+                        "\n\t - Frame Stats: " +
+                        (gasyboy::provider::UtilitiesProvider::getInstance()->frameStats ? "true" : "false") +
+                        "\n\t - Emulation Thread: " +
+                        (gasyboy::provider::UtilitiesProvider::getInstance()->threadedEmulation ? "true" : "false") +
+                        "\n\t - Speed: " + speed +
+                        "\n\t - Rewind: " + std::to_string(gasyboy::provider::UtilitiesProvider::getInstance()->rewindSeconds) + " s" +
+                        "\n\t - Run-ahead: " + std::to_string(gasyboy::provider::UtilitiesProvider::getInstance()->runAhead) + " frames");
 
         auto gb = gasyboy::provider::GameBoyProvider::getInstance();
+        if (program.is_used("--play"))
+        {
+            gb->playMovie(program.get<std::string>("--play"));
+        }
+        else if (program.is_used("--record"))
+        {
+            gb->recordMovie(program.get<std::string>("--record"));
+        }
         gb->boot();
     }
     catch (const std::runtime_error &err)
     {
         std::cout << err.what() << "\n";
         std::cout << "usage: gasyboy [-r | --rom rom_file_path] [--usebios]\n"
+                  << "       gasyboy --batch manifest [--report report_file] [-j | --jobs count]\n"
                   << "\t-r | --rom : the path to the rom file to load\n"
                   << "\t-s | --skip_bios : skip BIOS on boot (default: false)\n"
-                  << "\t-d | --debug : boot in debug mode (default: false)\n";
+                  << "\t-d | --debug : boot in debug mode (default: false)\n"
+                  << "\t-t | --threaded_ppu : render scanlines on a worker thread (default: false)\n"
+                  << "\t-v | --vsync : present on vsync (default: false)\n"
+                  << "\t--audio_sync : pace emulation by the audio device (default: false)\n"
+                  << "\t--audio_quality : resampling kernel, low, medium or high (default: medium)\n"
+                  << "\t-f | --frame_stats : log frame time jitter every second (default: false)\n"
+                  << "\t-x | --speed : emulation speed, 1, 2, 4 or uncapped (default: 1)\n"
+                  << "\t-w | --rewind : seconds of rewind history, hold Backspace to rewind (default: 60)\n"
+                  << "\t-a | --run_ahead : frames emulated ahead to cut input lag, cost logged with -f (default: 0)\n"
+                  << "\t--record : record the joypad into a movie file, from power-on\n"
+                  << "\t--play : replay a movie file, its divergence from the recording is logged\n"
+                  << "\t--exec_stats : write executions and cycles per opcode, ROM bank and address on exit\n"
+                  << "\t--profile : write a Chrome trace on exit, GASYBOY_PROFILER builds only\n"
+                  << "\t--single_thread : run emulation on the main thread (default: false)\n"
+                  << "\t--batch : run the test ROMs of a manifest headless, one per line:\n"
+                  << "\t          path [pass=text] [fail=text] [cycles=n] [hash=hex] [bios]\n"
+                  << "\t--report : batch report, JUnit for .xml files, JSON otherwise\n"
+                  << "\t-j | --jobs : test ROMs run at once (default: every core)\n";
+        return 1;
+    }
+    catch (const gasyboy::exception::GbException &e)
+    {
+        std::cout << e.what() << "\n";
         return 1;
     }
 
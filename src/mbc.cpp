@@ -3,19 +3,19 @@
 namespace gasyboy
 {
 
-    MBC0::MBC0(const std::vector<uint8_t> &rom) : _rom(rom)
+    MBC0::MBC0(const SharedRom &rom) : _rom(rom)
     {
     }
 
     uint8_t MBC0::readByte(const uint16_t &address)
     {
         if (address < 0x8000)
-            return _rom[address];
+            return (*_rom)[address];
 
         return 0;
     }
 
-    MBC1::MBC1(const std::vector<uint8_t> &rom, const std::vector<uint8_t> &ram, int romBanksCount, int ramBanksCount)
+    MBC1::MBC1(const SharedRom &rom, const std::vector<uint8_t> &ram, int romBanksCount, int ramBanksCount)
         : _rom(rom),
           _ram(ram),
           _romBanksCount(romBanksCount),
@@ -27,17 +27,41 @@ namespace gasyboy
     {
     }
 
+    void MBC1::saveState(StateWriter &writer)
+    {
+        writer.writeBool(_ramEnabled);
+        writer.writeBool(_mode);
+        writer.write8(_romBank);
+        writer.write8(_ramBank);
+        writer.write32(static_cast<uint32_t>(_ram.size()));
+        writer.writeBytes(_ram.data(), _ram.size());
+    }
+
+    void MBC1::loadState(StateReader &reader)
+    {
+        _ramEnabled = reader.readBool();
+        _mode = reader.readBool();
+        _romBank = reader.read8();
+        _ramBank = reader.read8();
+
+        if (reader.read32() != _ram.size())
+        {
+            throw exception::GbException("Save state cartridge RAM size mismatch");
+        }
+        reader.readBytes(_ram.data(), _ram.size());
+    }
+
     uint8_t MBC1::readByte(const uint16_t &address)
     {
         if (address < 0x4000)
         {
             int bank = _mode * (_ramBank << 5) % _romBanksCount;
-            return _rom[bank * 0x4000 + address];
+            return (*_rom)[bank * 0x4000 + address];
         }
         else if (address < 0x8000)
         {
             int bank = ((_ramBank << 5) | _romBank) % _romBanksCount;
-            return _rom[bank * 0x4000 + address - 0x4000];
+            return (*_rom)[bank * 0x4000 + address - 0x4000];
         }
         else if (address >= 0xA000 && address < 0xC000)
         {
@@ -81,12 +105,19 @@ namespace gasyboy
         }
     }
 
+    int MBC1::getRomBank(const uint16_t &address)
+    {
+        if (address < 0x4000)
+            return _mode * (_ramBank << 5) % _romBanksCount;
+        return ((_ramBank << 5) | _romBank) % _romBanksCount;
+    }
+
     uint8_t MBC2::readByte(const uint16_t &address)
     {
         if (address < 0x4000)
-            return _rom[address];
+            return (*_rom)[address];
         else if (address < 0x8000)
-            return _rom[_romBank * 0x4000 + address - 0x4000];
+            return (*_rom)[_romBank * 0x4000 + address - 0x4000];
         else if (address >= 0xA000 && address < 0xC000)
         {
             if (_ramEnabled)
@@ -115,12 +146,17 @@ namespace gasyboy
         }
     }
 
+    int MBC2::getRomBank(const uint16_t &address)
+    {
+        return address < 0x4000 ? 0 : _romBank;
+    }
+
     uint8_t MBC3::readByte(const uint16_t &address)
     {
         if (address < 0x4000)
-            return _rom[address];
+            return (*_rom)[address];
         else if (address < 0x8000)
-            return _rom[_romBank * 0x4000 + address - 0x4000];
+            return (*_rom)[_romBank * 0x4000 + address - 0x4000];
         else if (address >= 0xA000 && address < 0xC000)
         {
             if (_ramEnabled)
@@ -155,12 +191,17 @@ namespace gasyboy
         }
     }
 
+    int MBC3::getRomBank(const uint16_t &address)
+    {
+        return address < 0x4000 ? 0 : _romBank;
+    }
+
     uint8_t MBC5::readByte(const uint16_t &address)
     {
         if (address < 0x4000)
-            return _rom[address];
+            return (*_rom)[address];
         else if (address < 0x8000)
-            return _rom[_romBank * 0x4000 + address - 0x4000];
+            return (*_rom)[_romBank * 0x4000 + address - 0x4000];
         else if (address >= 0xA000 && address < 0xC000)
         {
             if (_ramEnabled)
@@ -187,4 +228,8 @@ namespace gasyboy
         }
     }
 
-}
\ No newline at end of file
+    int MBC5::getRomBank(const uint16_t &address)
+    {
+        return address < 0x4000 ? 0 : _romBank;
+    }
+}
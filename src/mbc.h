@@ -4,36 +4,52 @@
 #include <iostream>
 #include <cstdint>
 #include <vector>
+#include <memory>
 #include "gbException.h"
+#include "saveState.h"
 
 namespace gasyboy
 {
+    // ROM contents never change once loaded, instances forked from one another share them
+    using SharedRom = std::shared_ptr<const std::vector<uint8_t>>;
+
     class IMBC
     {
     public:
         virtual uint8_t readByte(const uint16_t &address) = 0;
         virtual void writeByte(const uint16_t &address, const uint8_t &value) = 0;
-        virtual std::vector<uint8_t> &getRom() = 0;
+        virtual const std::vector<uint8_t> &getRom() = 0;
         virtual std::vector<uint8_t> &getRam() = 0;
+
+        // ROM bank mapped at an address below 0x8000
+        virtual int getRomBank(const uint16_t &address) = 0;
+
+        // Bank registers and RAM, for save states
+        virtual void saveState(StateWriter &writer) = 0;
+        virtual void loadState(StateReader &reader) = 0;
+
         virtual ~IMBC() = default;
     };
 
     class MBC0 : public IMBC
     {
     public:
-        std::vector<uint8_t> _rom;
+        SharedRom _rom;
 
-        MBC0(const std::vector<uint8_t> &rom);
+        MBC0(const SharedRom &rom);
         virtual uint8_t readByte(const uint16_t &address) override;
         virtual void writeByte(const uint16_t &address, const uint8_t &value) override {}
-        virtual std::vector<uint8_t> &getRom() override { return _rom; }
+        virtual const std::vector<uint8_t> &getRom() override { return *_rom; }
         virtual std::vector<uint8_t> &getRam() override { throw exception::GbException("MBC0 does not have RAM"); }
+        virtual int getRomBank(const uint16_t &address) override { return address / 0x4000; }
+        virtual void saveState(StateWriter &writer) override {}
+        virtual void loadState(StateReader &reader) override {}
     };
 
     class MBC1 : public IMBC
     {
     public:
-        std::vector<uint8_t> _rom;
+        SharedRom _rom;
         std::vector<uint8_t> _ram;
         int _romBanksCount = 1;
         int _ramBanksCount = 1;
@@ -42,35 +58,41 @@ namespace gasyboy
         uint8_t _romBank;
         uint8_t _ramBank;
 
-        MBC1(const std::vector<uint8_t> &rom, const std::vector<uint8_t> &ram, int romBanksCount, int ramBanksCount);
+        MBC1(const SharedRom &rom, const std::vector<uint8_t> &ram, int romBanksCount, int ramBanksCount);
         virtual uint8_t readByte(const uint16_t &address) override;
         virtual void writeByte(const uint16_t &address, const uint8_t &value) override;
-        virtual std::vector<uint8_t> &getRom() override { return _rom; }
+        virtual const std::vector<uint8_t> &getRom() override { return *_rom; }
         virtual std::vector<uint8_t> &getRam() override { return _ram; }
+        virtual int getRomBank(const uint16_t &address) override;
+        virtual void saveState(StateWriter &writer) override;
+        virtual void loadState(StateReader &reader) override;
     };
 
     class MBC2 : public MBC1
     {
     public:
-        MBC2(const std::vector<uint8_t> &rom, const std::vector<uint8_t> &ram, int romBanksCount, int ramBanksCount) : MBC1(rom, ram, romBanksCount, ramBanksCount) {}
+        MBC2(const SharedRom &rom, const std::vector<uint8_t> &ram, int romBanksCount, int ramBanksCount) : MBC1(rom, ram, romBanksCount, ramBanksCount) {}
         uint8_t readByte(const uint16_t &address);
         void writeByte(const uint16_t &address, const uint8_t &value);
+        int getRomBank(const uint16_t &address);
     };
 
     class MBC3 : public MBC1
     {
     public:
-        MBC3(const std::vector<uint8_t> &rom, const std::vector<uint8_t> &ram, int romBanksCount, int ramBanksCount) : MBC1(rom, ram, romBanksCount, ramBanksCount) {}
+        MBC3(const SharedRom &rom, const std::vector<uint8_t> &ram, int romBanksCount, int ramBanksCount) : MBC1(rom, ram, romBanksCount, ramBanksCount) {}
         uint8_t readByte(const uint16_t &address);
         void writeByte(const uint16_t &address, const uint8_t &value);
+        int getRomBank(const uint16_t &address);
     };
 
     class MBC5 : public MBC1
     {
     public:
-        MBC5(const std::vector<uint8_t> &rom, const std::vector<uint8_t> &ram, int romBanksCount, int ramBanksCount) : MBC1(rom, ram, romBanksCount, ramBanksCount) {}
+        MBC5(const SharedRom &rom, const std::vector<uint8_t> &ram, int romBanksCount, int ramBanksCount) : MBC1(rom, ram, romBanksCount, ramBanksCount) {}
         uint8_t readByte(const uint16_t &address);
         void writeByte(const uint16_t &address, const uint8_t &value);
+        int getRomBank(const uint16_t &address);
     };
 }
 
@@ -1,20 +1,31 @@
 #include <cstring>
-#include "utilitiesProvider.h"
-#include "gamepadProvider.h"
 #include "gbException.h"
 #include "logger.h"
 #include "timer.h"
+#include "interruptManager.h"
+#include "apu.h"
 #include "mmu.h"
-#include "timerProvider.h"
 
 namespace gasyboy
 {
-    Mmu::Mmu(const uint8_t *bytes, const size_t &romSize)
+    Mmu::Mmu(Utilities &utilities, Gamepad &gamepad, Timer &timer, InterruptManager &interruptManager, Apu &apu, const uint8_t *bytes, const size_t &romSize)
         : _memory(0x10000, 0),
-          _biosEnabled(provider::UtilitiesProvider::getInstance()->executeBios),
-          _gamepad(provider::GamepadProvider::getInstance()),
-          _cartridge()
+          _biosEnabled(utilities.executeBios),
+          _utilities(utilities),
+          _gamepad(gamepad),
+          _timer(timer),
+          _interruptManager(interruptManager),
+          _apu(apu),
+          _cartridge(),
+          _videoWriteLog(nullptr)
     {
+        if (!_biosEnabled)
+        {
+            _memory[0xFF40] = 0x91;
+            _memory[0xFF47] = 0xFC;
+            _memory[0xFF48] = 0xFF;
+        }
+
         // setting joypad to off
         _memory[0xFF00] = 0xFF;
 
@@ -27,6 +38,7 @@ namespace gasyboy
         }
         catch (const exception::GbException &e)
         {
+            _romLoadError = e.what();
             utils::Logger::getInstance()->log(utils::Logger::LogType::CRITICAL,
                                               e.what());
         }
@@ -35,25 +47,40 @@ namespace gasyboy
         this->loadRam();
     }
 
+    Mmu::Mmu(Utilities &utilities, Gamepad &gamepad, Timer &timer, InterruptManager &interruptManager, Apu &apu, const Cartridge &cartridge)
+        : _memory(0x10000, 0),
+          _biosEnabled(utilities.executeBios),
+          _utilities(utilities),
+          _gamepad(gamepad),
+          _timer(timer),
+          _interruptManager(interruptManager),
+          _apu(apu),
+          _cartridge(),
+          _videoWriteLog(nullptr)
+    {
+        // The rest of the memory comes from the state loaded right after
+        _memory[0xFF00] = 0xFF;
+        _cartridge.shareRom(cartridge);
+    }
+
     Mmu &Mmu::operator=(const gasyboy::Mmu &other)
     {
-        {
-            for (int i = 0; i < 0x10000; i++)
-            {
-                _memory[i] = other._memory[i];
-            }
-            _biosEnabled = provider::UtilitiesProvider::getInstance()->executeBios;
-            _gamepad = other._gamepad;
-            _cartridge = other._cartridge;
-            return *this;
-        }
+        _memory = other._memory;
+        _biosEnabled = other._biosEnabled;
+        _cartridge = other._cartridge;
+        return *this;
     }
 
-    Mmu::Mmu()
+    Mmu::Mmu(Utilities &utilities, Gamepad &gamepad, Timer &timer, InterruptManager &interruptManager, Apu &apu)
         : _memory(0x10000, 0),
-          _biosEnabled(provider::UtilitiesProvider::getInstance()->executeBios),
+          _biosEnabled(utilities.executeBios),
           _cartridge(),
-          _gamepad(provider::GamepadProvider::getInstance())
+          _utilities(utilities),
+          _gamepad(gamepad),
+          _timer(timer),
+          _interruptManager(interruptManager),
+          _apu(apu),
+          _videoWriteLog(nullptr)
 
     {
         if (!_biosEnabled)
@@ -69,18 +96,19 @@ namespace gasyboy
         // loading rom file
         try
         {
-            if (provider::UtilitiesProvider::getInstance()->romFilePath.empty())
+            if (_utilities.romFilePath.empty())
             {
                 throw exception::GbException("Invalid rom file path");
             }
 
-            _cartridge.loadRom(provider::UtilitiesProvider::getInstance()->romFilePath);
+            _cartridge.loadRom(_utilities.romFilePath);
             utils::Logger::getInstance()->log(utils::Logger::LogType::FUNCTIONAL,
                                               "Rom file : \"" +
-                                                  provider::UtilitiesProvider::getInstance()->romFilePath + "\" loaded successfully");
+                                                  _utilities.romFilePath + "\" loaded successfully");
         }
         catch (const exception::GbException &e)
         {
+            _romLoadError = e.what();
             utils::Logger::getInstance()->log(utils::Logger::LogType::CRITICAL,
                                               e.what());
         }
@@ -89,9 +117,75 @@ namespace gasyboy
         this->loadRam();
     }
 
+    void Mmu::saveState(StateWriter &writer)
+    {
+        writer.writeBytes(_memory.data(), _memory.size());
+        writer.writeBool(_biosEnabled);
+
+        // Decoded caches are saved as is, rebuilding them from VRAM/OAM costs more than copying
+        writer.writeBytes(palette_BGP, sizeof(palette_BGP));
+        writer.writeBytes(palette_OBP0, sizeof(palette_OBP0));
+        writer.writeBytes(palette_OBP1, sizeof(palette_OBP1));
+        writer.write8(register_BGP);
+        writer.write8(register_OBP0);
+        writer.write8(register_OBP1);
+        writer.writeBytes(tiles, sizeof(tiles));
+
+        for (const auto &sprite : sprites)
+        {
+            writer.writeBool(sprite.ready);
+            writer.write32(static_cast<uint32_t>(sprite.y));
+            writer.write32(static_cast<uint32_t>(sprite.x));
+            writer.write8(sprite.tile);
+            writer.write8(sprite.options.value);
+            writer.write8(sprite.colourPalette == palette_OBP0 ? 1 : sprite.colourPalette == palette_OBP1 ? 2
+                                                                                                          : 0);
+        }
+
+        _cartridge.saveState(writer);
+    }
+
+    void Mmu::loadState(StateReader &reader)
+    {
+        reader.readBytes(_memory.data(), _memory.size());
+        _biosEnabled = reader.readBool();
+
+        reader.readBytes(palette_BGP, sizeof(palette_BGP));
+        reader.readBytes(palette_OBP0, sizeof(palette_OBP0));
+        reader.readBytes(palette_OBP1, sizeof(palette_OBP1));
+        register_BGP = reader.read8();
+        register_OBP0 = reader.read8();
+        register_OBP1 = reader.read8();
+        reader.readBytes(tiles, sizeof(tiles));
+
+        for (auto &sprite : sprites)
+        {
+            sprite.ready = reader.readBool();
+            sprite.y = static_cast<int>(reader.read32());
+            sprite.x = static_cast<int>(reader.read32());
+            sprite.tile = reader.read8();
+            sprite.options.value = reader.read8();
+
+            // Palette pointers are stored as an index, they point into this instance
+            switch (reader.read8())
+            {
+            case 1:
+                sprite.colourPalette = palette_OBP0;
+                break;
+            case 2:
+                sprite.colourPalette = palette_OBP1;
+                break;
+            default:
+                sprite.colourPalette = nullptr;
+            }
+        }
+
+        _cartridge.loadState(reader);
+    }
+
     void Mmu::reset()
     {
-        _biosEnabled = provider::UtilitiesProvider::getInstance()->executeBios;
+        _biosEnabled = _utilities.executeBios;
         _memory.assign(0x10000, 0);
 
         if (!_biosEnabled)
@@ -101,27 +195,26 @@ namespace gasyboy
             _memory[0xFF48] = 0xFF;
         }
 
-        // setting joypad to off
-        _memory[0xFFFF] = 0xFF;
-
-        // loading rom file
-        if (!provider::UtilitiesProvider::getInstance()->wasReset)
+        // loading rom file, unless it is a plain reset of the ROM already inserted
+        if (!_utilities.wasReset || _cartridge.getRomFilePath() != _utilities.romFilePath)
         {
             _cartridge.reset();
+            _romLoadError.clear();
             try
             {
-                if (provider::UtilitiesProvider::getInstance()->romFilePath.empty())
+                if (_utilities.romFilePath.empty())
                 {
                     throw exception::GbException("Invalid rom file path");
                 }
 
-                _cartridge.loadRom(provider::UtilitiesProvider::getInstance()->romFilePath);
+                _cartridge.loadRom(_utilities.romFilePath);
                 utils::Logger::getInstance()->log(utils::Logger::LogType::FUNCTIONAL,
                                                   "Rom file : \"" +
-                                                      provider::UtilitiesProvider::getInstance()->romFilePath + "\" loaded successfully");
+                                                      _utilities.romFilePath + "\" loaded successfully");
             }
             catch (const exception::GbException &e)
             {
+                _romLoadError = e.what();
                 utils::Logger::getInstance()->log(utils::Logger::LogType::CRITICAL,
                                                   e.what());
             }
@@ -131,6 +224,11 @@ namespace gasyboy
         this->loadRam();
     }
 
+    const std::string &Mmu::getRomLoadError()
+    {
+        return _romLoadError;
+    }
+
     void Mmu::disableBios()
     {
         _biosEnabled = false;
@@ -141,25 +239,41 @@ namespace gasyboy
         return _biosEnabled;
     }
 
+    int Mmu::getRomBank(const uint16_t &address)
+    {
+        if (address >= 0x8000 || (address < 0x100 && _biosEnabled))
+        {
+            return -1;
+        }
+        return _cartridge.getRomBank(address);
+    }
+
     uint8_t Mmu::readRam(const uint16_t &address)
     {
         if (address == 0xff00)
         {
-            return _gamepad->getState();
+            return _gamepad.getState();
         }
 
         // Timers
         else if (address == 0xff04)
-            return provider::TimerProvider::getInstance()->DIV();
+            return _timer.DIV();
         else if (address == 0xff05)
-            return provider::TimerProvider::getInstance()->TIMA();
+            return _timer.TIMA();
         else if (address == 0xff06)
-            return provider::TimerProvider::getInstance()->TMA();
+            return _timer.TMA();
         else if (address == 0xff07)
-            return provider::TimerProvider::getInstance()->TAC();
+            return _timer.TAC();
 
-        if (address == 0xff0f)
-            return _memory[0xFF0F];
+        // Interrupts
+        else if (address == 0xff0f)
+            return _interruptManager.IF();
+        else if (address == 0xffff)
+            return _interruptManager.IE();
+
+        // Sound
+        else if (address >= 0xff10 && address <= 0xff3f)
+            return _apu.read(address);
 
         // Switchable ROM banks
         if (address < 0x8000)
@@ -188,6 +302,8 @@ namespace gasyboy
         else if (address >= 0x8000 && address < 0xA000)
         {
             _memory[address] = value;
+            if (_videoWriteLog)
+                _videoWriteLog->push_back({address, value});
             if (address >= 0x8000 && address < 0x9800)
             {
                 updateTile(address);
@@ -213,6 +329,8 @@ namespace gasyboy
 
             else if (address >= 0xFE00 && address <= 0xFE9F)
             {
+                if (_videoWriteLog)
+                    _videoWriteLog->push_back({address, value});
                 updateSprite(address, value);
                 _memory[address] = value;
                 return;
@@ -229,7 +347,7 @@ namespace gasyboy
             // Joypad register
             else if (address == 0xFF00)
             {
-                _gamepad->setState(value);
+                _gamepad.setState(value);
             }
 
             // for Serial IN/OUT
@@ -237,33 +355,55 @@ namespace gasyboy
             { // only for Blargg Test roms debugging, TODO: implement serial transfer protocol
                 if (value == 0x81)
                 {
-                    std::string serialCharOutput(1, static_cast<char>(_memory[0xFF01]));
-                    utils::Logger::getInstance()->log(utils::Logger::LogType::DEBUG, serialCharOutput);
+                    if (_serialHandler)
+                    {
+                        _serialHandler(_memory[0xFF01]);
+                    }
+                    else
+                    {
+                        utils::Logger::getInstance()->log<utils::Logger::LogType::SERIAL_DEBUG>(static_cast<char>(_memory[0xFF01]));
+                    }
                 }
             }
 
             // writing to DIV register reset its counter
             else if (address == 0xFF04)
             {
-                provider::TimerProvider::getInstance()->setDIV(0);
+                _timer.setDIV(0);
             }
 
             // TIMA timer
             else if (address == 0xFF05)
             {
-                provider::TimerProvider::getInstance()->setTIMA(value);
+                _timer.setTIMA(value);
             }
 
             // TMA timer
             else if (address == 0xFF06)
             {
-                provider::TimerProvider::getInstance()->setTMA(value);
+                _timer.setTMA(value);
             }
 
             // TAC Timer control
             else if (address == 0xFF07)
             {
-                provider::TimerProvider::getInstance()->setTAC(value);
+                _timer.setTAC(value);
+            }
+
+            // Interrupt flags and enable
+            else if (address == 0xFF0F)
+            {
+                _interruptManager.setIF(value);
+            }
+            else if (address == 0xFFFF)
+            {
+                _interruptManager.setIE(value);
+            }
+
+            // Sound registers and wave RAM
+            else if (address >= 0xFF10 && address <= 0xFF3F)
+            {
+                _apu.write(address, value);
             }
 
             // writing to LY register reset it
@@ -285,16 +425,19 @@ namespace gasyboy
             else if (address == 0xFF47)
             {
                 updatePalette(palette_BGP, value);
+                register_BGP = value;
                 return;
             }
             else if (address == 0xFF48)
             {
                 updatePalette(palette_OBP0, value);
+                register_OBP0 = value;
                 return;
             }
             else if (address == 0xFF49)
             {
                 updatePalette(palette_OBP1, value);
+                register_OBP1 = value;
                 return;
             }
             else if (address == 0xFF50 && value != 0)
@@ -353,24 +496,46 @@ namespace gasyboy
         _cartridge.loadRam();
     }
 
+    void Mmu::setVideoWriteLog(std::vector<VideoWrite> *log)
+    {
+        _videoWriteLog = log;
+    }
+
+    void Mmu::setSerialHandler(const std::function<void(const uint8_t &)> &handler)
+    {
+        _serialHandler = handler;
+    }
+
     void Mmu::updateTile(const uint16_t &laddress)
+    {
+        decodeTile(tiles, &_memory[0x8000], laddress);
+    }
+
+    void Mmu::updateSprite(const uint16_t &laddress, const uint8_t &value)
+    {
+        decodeSprite(sprites, laddress, value, palette_OBP0, palette_OBP1);
+    }
+
+    void Mmu::decodeTile(Tile *tiles, const uint8_t *vram, const uint16_t &laddress)
     {
         uint16_t address = laddress & 0xFFFE;
 
         uint16_t tile = (address >> 4) & 511;
         uint16_t y = (address >> 1) & 7;
 
+        const uint8_t low = vram[address - 0x8000];
+        const uint8_t high = vram[address - 0x8000 + 1];
+
         uint8_t bitIndex;
         for (uint8_t x = 0; x < 8; x++)
         {
             bitIndex = 1 << (7 - x);
 
-            tiles[tile].pixels[y][x] =
-                ((readRam(address) & bitIndex) ? 1 : 0) + ((readRam(address + 1) & bitIndex) ? 2 : 0);
+            tiles[tile].pixels[y][x] = ((low & bitIndex) ? 1 : 0) + ((high & bitIndex) ? 2 : 0);
         }
     }
 
-    void Mmu::updateSprite(const uint16_t &laddress, const uint8_t &value)
+    void Mmu::decodeSprite(Sprite *sprites, const uint16_t &laddress, const uint8_t &value, Colour *obp0, Colour *obp1)
     {
         uint16_t address = laddress - 0xFE00;
         Sprite *sprite = &sprites[address >> 2];
@@ -388,7 +553,7 @@ namespace gasyboy
             break;
         case 3:
             sprite->options.value = value;
-            sprite->colourPalette = (sprite->options.paletteNumber) ? palette_OBP1 : palette_OBP0;
+            sprite->colourPalette = (sprite->options.paletteNumber) ? obp1 : obp0;
             sprite->ready = true;
             break;
         }
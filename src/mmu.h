@@ -4,12 +4,18 @@
 #include "cartridge.h"
 #include "defs.h"
 #include "gamepad.h"
+#include "utilities.h"
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <vector>
 
 namespace gasyboy
 {
+  class Timer;
+  class InterruptManager;
+  class Apu;
+
   struct Colour
   {
     union
@@ -22,6 +28,13 @@ namespace gasyboy
     };
   };
 
+  // A write to VRAM or OAM, logged for deferred PPU rendering
+  struct VideoWrite
+  {
+    uint16_t address;
+    uint8_t value;
+  };
+
   class Mmu
   {
   private:
@@ -53,19 +66,43 @@ namespace gasyboy
     // boolean to check if reading from BIOS
     bool _biosEnabled;
 
+    // Emulator settings
+    Utilities &_utilities;
+
     // context of the gamepad
-    std::shared_ptr<Gamepad> _gamepad;
+    Gamepad &_gamepad;
+
+    // Timer registers live in the timer
+    Timer &_timer;
+
+    // So do IF and IE in the interrupt manager
+    InterruptManager &_interruptManager;
+
+    // And the sound registers and wave RAM in the APU
+    Apu &_apu;
 
     // The actual cartridge
     Cartridge _cartridge;
 
+    // Log of VRAM/OAM writes, only set while the PPU renders on a worker thread
+    std::vector<VideoWrite> *_videoWriteLog;
+
+    // Receives bytes sent over serial, they are logged when not set
+    std::function<void(const uint8_t &)> _serialHandler;
+
+    // Why the last ROM load failed, empty when it succeeded. Failures are only logged otherwise.
+    std::string _romLoadError;
+
   public:
     // memory region of the gaameboy
     std::vector<uint8_t> _memory;
 
     // construcor/destructor
-    Mmu();
-    Mmu(const uint8_t *bytes, const size_t &romSize);
+    Mmu(Utilities &utilities, Gamepad &gamepad, Timer &timer, InterruptManager &interruptManager, Apu &apu);
+    Mmu(Utilities &utilities, Gamepad &gamepad, Timer &timer, InterruptManager &interruptManager, Apu &apu, const uint8_t *bytes, const size_t &romSize);
+
+    // Share the ROM of another instance's cartridge, nothing is read from disk
+    Mmu(Utilities &utilities, Gamepad &gamepad, Timer &timer, InterruptManager &interruptManager, Apu &apu, const Cartridge &cartridge);
     Mmu &operator=(const gasyboy::Mmu &);
     ~Mmu() = default;
 
@@ -73,9 +110,16 @@ namespace gasyboy
     Cartridge &getCartridge();
     void setCartridge(const Cartridge &cartridge);
 
-    // Reset MMU
+    // Reset MMU, the cartridge is kept on a plain reset of the same ROM
     void reset();
 
+    // Empty when the ROM loaded, the error otherwise
+    const std::string &getRomLoadError();
+
+    // Save state, with the cartridge banking and RAM
+    void saveState(StateWriter &writer);
+    void loadState(StateReader &reader);
+
     // reading/writing into memory
     uint8_t readRam(const uint16_t &adrr);
     void writeRam(const uint16_t &adrr, const uint8_t &value);
@@ -86,6 +130,9 @@ namespace gasyboy
     // to check if the gameboy is in internal bios mode
     bool isInBios();
 
+    // ROM bank the CPU reads an address from, -1 for the BIOS and everything past the ROM
+    int getRomBank(const uint16_t &address);
+
     // graphic memory TODO: change functions names
     std::vector<uint8_t> getVram();
     std::vector<uint8_t> &getMemory();
@@ -97,6 +144,12 @@ namespace gasyboy
     // Load Ram from file
     void loadRam();
 
+    // Start/stop logging VRAM/OAM writes
+    void setVideoWriteLog(std::vector<VideoWrite> *log);
+
+    // Capture serial output, test ROMs report their results there
+    void setSerialHandler(const std::function<void(const uint8_t &)> &handler);
+
     // Usefull structs
     struct Sprite
     {
@@ -158,9 +211,18 @@ namespace gasyboy
         {0, 0, 0, 255},
     };
 
+    // Last values written to BGP/OBP0/OBP1, matching the palettes above
+    uint8_t register_BGP = 0xFC;
+    uint8_t register_OBP0 = 0xFF;
+    uint8_t register_OBP1 = 0xFF;
+
     void updateTile(const uint16_t &address);
     void updateSprite(const uint16_t &address, const uint8_t &value);
     void updatePalette(Colour *palette, uint8_t value);
+
+    // Decoders shared with the PPU render worker, which keeps its own copy of video memory
+    static void decodeTile(Tile *tiles, const uint8_t *vram, const uint16_t &address);
+    static void decodeSprite(Sprite *sprites, const uint16_t &address, const uint8_t &value, Colour *obp0, Colour *obp1);
   };
 } // namespace gasyboy
 
@@ -0,0 +1,91 @@
+#include "movie.h"
+#include "saveState.h"
+#include "gbException.h"
+#include <iterator>
+
+namespace gasyboy
+{
+    namespace
+    {
+        constexpr size_t HEADER_SIZE = 16;
+        constexpr size_t FRAME_SIZE = 10;
+        constexpr uint16_t FLAG_EXECUTE_BIOS = 1;
+        constexpr uint8_t FRAME_FLAG_WAKE = 1;
+
+        // Version 1 frames have no flags byte
+        constexpr uint16_t VERSION_WITHOUT_FLAGS = 1;
+    }
+
+    Movie Movie::load(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            throw exception::GbException("Unable to open movie: " + path);
+        }
+
+        const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        StateReader reader(bytes.data(), bytes.size());
+        if (bytes.size() < HEADER_SIZE || reader.read32() != MOVIE_MAGIC)
+        {
+            throw exception::GbException("Not a movie: " + path);
+        }
+        const uint16_t version = reader.read16();
+        if (version != MOVIE_VERSION && version != VERSION_WITHOUT_FLAGS)
+        {
+            throw exception::GbException("Unsupported movie version: " + path);
+        }
+        const bool hasFlags = version != VERSION_WITHOUT_FLAGS;
+
+        Movie movie;
+        movie.executeBios = reader.read16() & FLAG_EXECUTE_BIOS;
+        movie.romHash = reader.read64();
+
+        // A frame cut short by a crash while recording is dropped
+        movie.frames.resize((bytes.size() - HEADER_SIZE) / (hasFlags ? FRAME_SIZE : FRAME_SIZE - 1));
+        for (auto &frame : movie.frames)
+        {
+            frame.buttons = reader.read8();
+            frame.wake = hasFlags && (reader.read8() & FRAME_FLAG_WAKE);
+            frame.stateHash = reader.read64();
+        }
+
+        return movie;
+    }
+
+    MovieWriter::MovieWriter(const std::string &path, const uint64_t &romHash, const bool &executeBios)
+        : _file(path, std::ios::binary | std::ios::trunc),
+          _unflushedFrames(0)
+    {
+        if (!_file.is_open())
+        {
+            throw exception::GbException("Unable to write movie: " + path);
+        }
+
+        uint8_t header[HEADER_SIZE];
+        StateWriter writer(header, sizeof(header));
+        writer.write32(MOVIE_MAGIC);
+        writer.write16(MOVIE_VERSION);
+        writer.write16(executeBios ? FLAG_EXECUTE_BIOS : 0);
+        writer.write64(romHash);
+        _file.write(reinterpret_cast<const char *>(header), sizeof(header));
+    }
+
+    void MovieWriter::write(const MovieFrame &frame)
+    {
+        uint8_t bytes[FRAME_SIZE];
+        StateWriter writer(bytes, sizeof(bytes));
+        writer.write8(frame.buttons);
+        writer.write8(frame.wake ? FRAME_FLAG_WAKE : 0);
+        writer.write64(frame.stateHash);
+        _file.write(reinterpret_cast<const char *>(bytes), sizeof(bytes));
+
+        // Roughly once per second
+        if (++_unflushedFrames >= 60)
+        {
+            _file.flush();
+            _unflushedFrames = 0;
+        }
+    }
+}
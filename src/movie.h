@@ -0,0 +1,50 @@
+#ifndef _MOVIE_H_
+#define _MOVIE_H_
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace gasyboy
+{
+    // Movie file: "GBMV", version, flags, ROM hash, then one frame after the other until the end of the file.
+    // A movie always starts from power-on, integers are little endian.
+    static constexpr uint32_t MOVIE_MAGIC = 0x564D4247;
+    static constexpr uint16_t MOVIE_VERSION = 2;
+
+    // Joypad state applied at the start of a frame and hash of the core at its end.
+    // Frames spent entirely in STOP are not part of the movie.
+    struct MovieFrame
+    {
+        uint8_t buttons;
+
+        // The CPU was woken from STOP at frame start, possibly by a key that is not on the joypad
+        bool wake;
+
+        uint64_t stateHash;
+    };
+
+    struct Movie
+    {
+        uint64_t romHash = 0;
+        bool executeBios = false;
+        std::vector<MovieFrame> frames;
+
+        static Movie load(const std::string &path);
+    };
+
+    // Appends frames to a movie file as they are recorded, a crash loses at most the buffered ones
+    class MovieWriter
+    {
+        std::ofstream _file;
+        int _unflushedFrames;
+
+    public:
+        MovieWriter(const std::string &path, const uint64_t &romHash, const bool &executeBios);
+
+        void write(const MovieFrame &frame);
+    };
+}
+
+#endif
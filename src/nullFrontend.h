@@ -0,0 +1,34 @@
+#ifndef _NULL_FRONTEND_H_
+#define _NULL_FRONTEND_H_
+
+#include "frontend.h"
+
+namespace gasyboy
+{
+    // Frontend for headless runs: nothing is presented and no input comes in
+    class NullRenderer : public IRenderer
+    {
+    public:
+        void init(GameBoy &gameboy) override {}
+        void reset() override {}
+        void render() override {}
+        void render(const Colour *framebuffer) override {}
+        void renderDebugger() override {}
+        bool isDisplayPaced() override { return false; }
+        void countEmulatedFrame() override {}
+        size_t queuedAudioFrames() override { return 0; }
+        size_t audioCapacityFrames() override { return 0; }
+    };
+
+    class NullInputHandler : public IInputHandler
+    {
+    public:
+        void init(GameBoy &gameboy) override {}
+        void handleEvent() override {}
+
+        // Headless runs never idle
+        void waitEvent(const int &timeoutMs) override {}
+    };
+}
+
+#endif
@@ -1,50 +1,113 @@
-#include "interruptManagerProvider.h"
-#include "registersProvider.h"
-#include "mmuProvider.h"
+#include "ppuRenderWorker.h"
 #include "ppu.h"
+#include "profiler.h"
+#include <algorithm>
+#include <limits>
 
 namespace gasyboy
 {
-    Ppu::Ppu()
-        : _mmu(provider::MmuProvider::getInstance()),
-          _registers(provider::RegistersProvider::getInstance()),
-          _interruptManager(provider::InterruptManagerProvider::getInstance()),
+    Ppu::Ppu(Mmu &mmu, Registers &registers, InterruptManager &interruptManager, Utilities &utilities)
+        : _mmu(mmu),
+          _registers(registers),
+          _interruptManager(interruptManager),
+          _utilities(utilities),
           _modeClock(0)
     {
-        LCDC = reinterpret_cast<Control *>(&_mmu->_memory[0xff40]);
-        STAT = reinterpret_cast<Stat *>(&_mmu->_memory[0xff41]);
-        SCY = &_mmu->_memory[0xff42];
-        SCX = &_mmu->_memory[0xff43];
-        LY = &_mmu->_memory[0xff44];
-        LCY = &_mmu->_memory[0xff45];
-        WY = &_mmu->_memory[0xff4A];
-        WX = &_mmu->_memory[0xff4B];
+        LCDC = reinterpret_cast<Control *>(&_mmu._memory[0xff40]);
+        STAT = reinterpret_cast<Stat *>(&_mmu._memory[0xff41]);
+        SCY = &_mmu._memory[0xff42];
+        SCX = &_mmu._memory[0xff43];
+        LY = &_mmu._memory[0xff44];
+        LCY = &_mmu._memory[0xff45];
+        WY = &_mmu._memory[0xff4A];
+        WX = &_mmu._memory[0xff4B];
+
+        // Black until the first frame is drawn
+        std::fill(_framebuffer, _framebuffer + 160 * 144, Colour{});
+        std::fill(_shadebuffer, _shadebuffer + 160 * 144, 3);
+
+        setThreadedRendering(_utilities.threadedPpu);
+    }
+
+    Ppu::~Ppu()
+    {
+        setThreadedRendering(false);
+    }
+
+    void FrameRecord::clear()
+    {
+        lineCount = 0;
+        videoWrites.clear();
+    }
+
+    void Ppu::setThreadedRendering(const bool &enabled)
+    {
+        if (enabled == isThreadedRendering())
+            return;
+
+        if (enabled)
+        {
+            // The worker starts from a copy of the current video memory, then follows the write log
+            _renderWorker = std::make_unique<PpuRenderWorker>(_framebuffer, _shadebuffer, _framebufferMutex);
+            _renderWorker->synchronize(_mmu, windowLineCounter);
+            _frameRecord.clear();
+            _mmu.setVideoWriteLog(&_frameRecord.videoWrites);
+        }
+        else
+        {
+            // Scanlines already recorded for this frame still have to be drawn
+            if (_frameRecord.lineCount > 0)
+            {
+                submitFrameRecord();
+            }
+            _renderWorker->wait();
+            windowLineCounter = _renderWorker->getWindowLineCounter();
+
+            _mmu.setVideoWriteLog(nullptr);
+            _renderWorker.reset();
+            _frameRecord.clear();
+        }
+    }
+
+    bool Ppu::isThreadedRendering()
+    {
+        return _renderWorker != nullptr;
+    }
+
+    void Ppu::finishRendering()
+    {
+        if (_renderWorker)
+            _renderWorker->wait();
+    }
+
+    void Ppu::setVBlankHandler(const std::function<void()> &handler)
+    {
+        _vblankHandler = handler;
     }
 
     Ppu &Ppu::operator=(const Ppu &other)
     {
-        _mmu = other._mmu;
-        _registers = other._registers;
-        _interruptManager = other._interruptManager;
+        // Register pointers stay on this instance's MMU
         _modeClock = other._modeClock;
-        LCDC = other.LCDC;
-        STAT = other.STAT;
-        SCY = other.SCY;
-        SCX = other.SCX;
-        LY = other.LY;
-        LCY = other.LCY;
-        WY = other.WY;
-        WX = other.WX;
         for (int i = 0; i < 160 * 144; i++)
             _framebuffer[i] = other._framebuffer[i];
+        std::copy(other._shadebuffer, other._shadebuffer + 160 * 144, _shadebuffer);
         _canRender = other._canRender;
         return *this;
     }
 
     void Ppu::step(const int &cycle)
     {
+        GASYBOY_PROFILE_SCOPE("Ppu::step");
+
         if (!LCDC->lcdEnable)
         {
+            // Flush a partially recorded frame so its scanlines still get drawn
+            if (_renderWorker && _frameRecord.lineCount > 0)
+            {
+                submitFrameRecord();
+            }
+
             *LY = 0;
             STAT->modeFlag = PpuMode::HBLANK;
             _modeClock = 0;
@@ -66,7 +129,10 @@ namespace gasyboy
         case PpuMode::DRAWING:
             if (_modeClock >= 172)
             {
-                renderScanLines();
+                if (_renderWorker)
+                    recordScanLine();
+                else
+                    renderScanLines();
                 _modeClock -= 172;
                 setMode(PpuMode::HBLANK);
             }
@@ -80,7 +146,14 @@ namespace gasyboy
                 if (*LY == 144)
                 {
                     setMode(PpuMode::VBLANK);
-                    _interruptManager->requestInterrupt(InterruptManager::InterruptType::VBlank);
+                    _interruptManager.requestInterrupt(InterruptManager::InterruptType::VBlank);
+
+                    // Hand the recorded frame to the worker, it is drawn while the next one is emulated
+                    if (_renderWorker)
+                        submitFrameRecord();
+
+                    if (_vblankHandler)
+                        _vblankHandler();
                 }
                 else
                 {
@@ -97,6 +170,7 @@ namespace gasyboy
                 if (*LY > 153)
                 {
                     _canRender = true;
+                    _frameCount++;
                     // *LY = 0;
                     setMode(PpuMode::OAM_SEARCH);
                 }
@@ -105,6 +179,17 @@ namespace gasyboy
         }
     }
 
+    int Ppu::cyclesToNextMode()
+    {
+        if (!LCDC->lcdEnable)
+        {
+            return std::numeric_limits<int>::max();
+        }
+
+        static constexpr int modeLength[4] = {204, 456, 80, 172};
+        return std::max(0, modeLength[STAT->modeFlag] - _modeClock);
+    }
+
     void Ppu::setMode(PpuMode mode)
     {
         STAT->modeFlag = static_cast<uint8_t>(mode);
@@ -114,19 +199,19 @@ namespace gasyboy
         case PpuMode::OAM_SEARCH:
             if (STAT->oamInterrupt)
             {
-                _interruptManager->requestInterrupt(InterruptManager::InterruptType::LCDStat);
+                _interruptManager.requestInterrupt(InterruptManager::InterruptType::LCDStat);
             }
             break;
         case PpuMode::HBLANK:
             if (STAT->hblankInterrupt)
             {
-                _interruptManager->requestInterrupt(InterruptManager::InterruptType::LCDStat);
+                _interruptManager.requestInterrupt(InterruptManager::InterruptType::LCDStat);
             }
             break;
         case PpuMode::VBLANK:
             if (STAT->vblankInterrupt)
             {
-                _interruptManager->requestInterrupt(InterruptManager::InterruptType::LCDStat);
+                _interruptManager.requestInterrupt(InterruptManager::InterruptType::LCDStat);
             }
             break;
         default:
@@ -140,7 +225,7 @@ namespace gasyboy
         if (*LY == 144)
         {
             setMode(PpuMode::VBLANK);
-            _interruptManager->requestInterrupt(InterruptManager::InterruptType::VBlank);
+            _interruptManager.requestInterrupt(InterruptManager::InterruptType::VBlank);
         }
 
         if (*LY == *LCY)
@@ -148,7 +233,7 @@ namespace gasyboy
             STAT->coincidenceFlag = 1;
             if (STAT->coincidenceInterrupt)
             {
-                _interruptManager->requestInterrupt(InterruptManager::InterruptType::LCDStat);
+                _interruptManager.requestInterrupt(InterruptManager::InterruptType::LCDStat);
             }
         }
         else
@@ -157,50 +242,97 @@ namespace gasyboy
         }
     }
 
+    ScanlineState Ppu::captureScanlineState()
+    {
+        ScanlineState state;
+        state.ly = *LY;
+        state.lcdc = LCDC->value;
+        state.scx = *SCX;
+        state.scy = *SCY;
+        state.wx = *WX;
+        state.wy = *WY;
+        std::copy(_mmu.palette_BGP, _mmu.palette_BGP + 4, state.bgp);
+        std::copy(_mmu.palette_OBP0, _mmu.palette_OBP0 + 4, state.obp0);
+        std::copy(_mmu.palette_OBP1, _mmu.palette_OBP1 + 4, state.obp1);
+        state.bgpValue = _mmu.register_BGP;
+        state.obp0Value = _mmu.register_OBP0;
+        state.obp1Value = _mmu.register_OBP1;
+        state.videoWriteCount = static_cast<uint32_t>(_frameRecord.videoWrites.size());
+        return state;
+    }
+
     void Ppu::renderScanLines()
+    {
+        GASYBOY_PROFILE_SCOPE("Ppu::renderScanLines");
+
+        const ScanlineSource source = {&_mmu._memory[0x8000], _mmu.tiles, _mmu.sprites};
+        drawScanLine(captureScanlineState(), source, windowLineCounter, _framebuffer, _shadebuffer);
+    }
+
+    void Ppu::recordScanLine()
+    {
+        if (_frameRecord.lineCount < _frameRecord.lines.size())
+        {
+            _frameRecord.lines[_frameRecord.lineCount++] = captureScanlineState();
+        }
+    }
+
+    void Ppu::submitFrameRecord()
+    {
+        _renderWorker->submit(_frameRecord);
+        _frameRecord.clear();
+    }
+
+    void Ppu::drawScanLine(const ScanlineState &state, const ScanlineSource &source, int &windowLineCounter, Colour *framebuffer, uint8_t *shadebuffer)
     {
         // Initialize the rowPixels array to false for all 160 pixels.
         bool rowPixels[160] = {0};
 
+        Control lcdc;
+        lcdc.value = state.lcdc;
+
         // If the Background Enable bit is set, render BG and window.
-        if (LCDC->bgDisplay)
+        if (lcdc.bgDisplay)
         {
-            renderScanLineBackground(rowPixels);
+            renderScanLineBackground(state, source, rowPixels, framebuffer, shadebuffer);
 
             // Pass rowPixels to window rendering so nonzero window pixels are marked.
-            if (LCDC->windowEnable)
+            if (lcdc.windowEnable)
             {
-                renderScanLineWindow(rowPixels);
+                renderScanLineWindow(state, source, rowPixels, windowLineCounter, framebuffer, shadebuffer);
             }
         }
 
         // Render sprites (they use rowPixels to check BG priority).
-        if (LCDC->spriteDisplayEnable)
+        if (lcdc.spriteDisplayEnable)
         {
-            renderScanLineSprites(rowPixels);
+            renderScanLineSprites(state, source, rowPixels, framebuffer, shadebuffer);
         }
     }
 
-    void Ppu::renderScanLineBackground(bool *rowPixels)
+    void Ppu::renderScanLineBackground(const ScanlineState &state, const ScanlineSource &source, bool *rowPixels, Colour *framebuffer, uint8_t *shadebuffer)
     {
+        Control lcdc;
+        lcdc.value = state.lcdc;
+
         // 1. Base tilemap address
         uint16_t tileMapBase = 0x9800;
-        if (LCDC->bgDisplaySelect)
+        if (lcdc.bgDisplaySelect)
             tileMapBase += 0x400; // switch to 9C00 region
 
         // 2. Compute the absolute y in the 256x256 BG, then wrap to 0–255
-        uint8_t y = *LY + *SCY;
+        uint8_t y = state.ly + state.scy;
         //    tileRow = which of the 32 tile rows (0–31)
         uint8_t tileRow = (y >> 3) & 31;
         //    line inside that tile (0–7)
         uint8_t tileLine = y & 7;
 
         // 3. Similarly, find the starting tile column (0–31), plus the pixel offset within that tile (0–7).
-        uint8_t xOffset = *SCX & 7;
-        uint8_t tileColumn = (*SCX >> 3) & 31;
+        uint8_t xOffset = state.scx & 7;
+        uint8_t tileColumn = (state.scx >> 3) & 31;
 
         // 4. Start writing into the framebuffer at this scanline
-        int pixelOffset = *LY * SCREEN_WIDTH;
+        int pixelOffset = state.ly * SCREEN_WIDTH;
         int screenX = 0; // which x pixel on this scanline?
 
         // 5. Each tile is 8 pixels wide. We need ~21 tiles to cover 160 px.
@@ -212,9 +344,9 @@ namespace gasyboy
             uint16_t tileMapAddr = tileMapBase + tileRow * 32 + tileColumn;
 
             // Read the tile index from VRAM
-            int tileIndex = _mmu->readRam(tileMapAddr);
+            int tileIndex = source.vram[tileMapAddr - 0x8000];
             // If in signed addressing mode (bgWindowDataSelect=0) and tileIndex<128, adjust by +256
-            if (!LCDC->bgWindowDataSelect && tileIndex < 128)
+            if (!lcdc.bgWindowDataSelect && tileIndex < 128)
                 tileIndex += 256;
 
             // 6. Draw up to 8 pixels from this tile, starting at xOffset
@@ -223,8 +355,9 @@ namespace gasyboy
                 if (pixelOffset >= SCREEN_WIDTH * SCREEN_HEIGHT)
                     return;
 
-                int colorIndex = _mmu->tiles[tileIndex].pixels[tileLine][xOffset];
-                _framebuffer[pixelOffset + screenX] = _mmu->palette_BGP[colorIndex];
+                int colorIndex = source.tiles[tileIndex].pixels[tileLine][xOffset];
+                framebuffer[pixelOffset + screenX] = state.bgp[colorIndex];
+                shadebuffer[pixelOffset + screenX] = (state.bgpValue >> (colorIndex * 2)) & 3;
 
                 // Mark rowPixels if BG pixel is nonzero
                 if (colorIndex > 0)
@@ -241,33 +374,36 @@ namespace gasyboy
 
     // Updated renderScanLineWindow: now accepts rowPixels so that any nonzero
     // window pixel is marked (hiding BG-priority sprites).
-    void Ppu::renderScanLineWindow(bool *rowPixels)
+    void Ppu::renderScanLineWindow(const ScanlineState &state, const ScanlineSource &source, bool *rowPixels, int &windowLineCounter, Colour *framebuffer, uint8_t *shadebuffer)
     {
         // Only render the window if LY has reached WY and WX is valid.
-        if (*LY < *WY || *WX >= 167)
+        if (state.ly < state.wy || state.wx >= 167)
             return;
 
         // Reset the window internal line counter on the very first window line.
-        if (*LY == *WY)
+        if (state.ly == state.wy)
             windowLineCounter = 0;
 
-        uint8_t wx = *WX;
-        uint16_t baseAddress = LCDC->windowDisplaySelect ? 0x9C00 : 0x9800;
+        Control lcdc;
+        lcdc.value = state.lcdc;
+
+        uint8_t wx = state.wx;
+        uint16_t baseAddress = lcdc.windowDisplaySelect ? 0x9C00 : 0x9800;
 
         // Use the internal window counter (which starts at 0 when the window first appears)
         int tileY = windowLineCounter / 8;
         int pixelYInTile = windowLineCounter % 8;
         uint16_t tileMapRowAddr = baseAddress + tileY * 32;
 
-        int pixelOffset = *LY * SCREEN_WIDTH;
+        int pixelOffset = state.ly * SCREEN_WIDTH;
         int startX = wx - 7;
 
         // Draw up to 21 tiles covering the screen horizontally
         for (int tileX = 0; tileX < 21; tileX++)
         {
             uint16_t tileAddress = tileMapRowAddr + tileX;
-            int tileIndex = _mmu->readRam(tileAddress);
-            if (!LCDC->bgWindowDataSelect && tileIndex < 128)
+            int tileIndex = source.vram[tileAddress - 0x8000];
+            if (!lcdc.bgWindowDataSelect && tileIndex < 128)
                 tileIndex += 256;
 
             for (int x = 0; x < 8; x++)
@@ -281,9 +417,10 @@ namespace gasyboy
                 if (windowPixelX < 0)
                     continue;
 
-                int colorIndex = _mmu->tiles[tileIndex].pixels[pixelYInTile][x];
+                int colorIndex = source.tiles[tileIndex].pixels[pixelYInTile][x];
                 int frameIndex = pixelOffset + windowPixelX;
-                _framebuffer[frameIndex] = _mmu->palette_BGP[colorIndex];
+                framebuffer[frameIndex] = state.bgp[colorIndex];
+                shadebuffer[frameIndex] = (state.bgpValue >> (colorIndex * 2)) & 3;
                 if (colorIndex > 0)
                     rowPixels[windowPixelX] = true;
             }
@@ -293,9 +430,12 @@ namespace gasyboy
         windowLineCounter++;
     }
 
-    void Ppu::renderScanLineSprites(bool *rowPixels)
+    void Ppu::renderScanLineSprites(const ScanlineState &state, const ScanlineSource &source, bool *rowPixels, Colour *framebuffer, uint8_t *shadebuffer)
     {
-        int spriteHeight = LCDC->spriteSize ? 16 : 8;
+        Control lcdc;
+        lcdc.value = state.lcdc;
+
+        int spriteHeight = lcdc.spriteSize ? 16 : 8;
         int spritesRendered = 0;
 
         // For each x coordinate on the scanline, store the sprite.x value of
@@ -309,10 +449,10 @@ namespace gasyboy
         // Process all 40 sprites from OAM.
         for (int i = 0; i < 40; i++)
         {
-            auto &sprite = _mmu->sprites[i];
+            auto &sprite = source.sprites[i];
 
-            // Check if the current scanline (*LY) is within the sprite's vertical bounds.
-            if (*LY < sprite.y || *LY >= sprite.y + spriteHeight)
+            // Check if the current scanline is within the sprite's vertical bounds.
+            if (state.ly < sprite.y || state.ly >= sprite.y + spriteHeight)
                 continue;
 
             // Limit to 10 sprites per scanline.
@@ -320,21 +460,25 @@ namespace gasyboy
                 break;
 
             // Calculate the vertical offset within the sprite.
-            int spriteY = *LY - sprite.y;
+            int spriteY = state.ly - sprite.y;
             if (sprite.options.yFlip)
                 spriteY = spriteHeight - 1 - spriteY;
 
             // In 8x16 mode, force tile index to be even.
-            int baseTileIndex = LCDC->spriteSize ? (sprite.tile & 0xFE) : sprite.tile;
+            int baseTileIndex = lcdc.spriteSize ? (sprite.tile & 0xFE) : sprite.tile;
             int tileIndex = baseTileIndex;
 
             // For 8x16 sprites, if in the bottom half, select the second tile.
-            if (LCDC->spriteSize && spriteY >= 8)
+            if (lcdc.spriteSize && spriteY >= 8)
             {
                 tileIndex += 1;
                 spriteY -= 8; // Adjust offset to index into the correct row of the second tile.
             }
 
+            // The palette latched for this scanline (colourPalette only tells if the attributes were written)
+            const Colour *palette = sprite.options.paletteNumber ? state.obp1 : state.obp0;
+            const uint8_t paletteValue = sprite.options.paletteNumber ? state.obp1Value : state.obp0Value;
+
             // Process each of the 8 horizontal pixels in the sprite.
             for (int x = 0; x < 8; x++)
             {
@@ -351,7 +495,7 @@ namespace gasyboy
                 int spriteX = sprite.options.xFlip ? 7 - x : x;
 
                 // Fetch the color index from the tile pixel data.
-                int colour = _mmu->tiles[tileIndex].pixels[spriteY][spriteX];
+                int colour = source.tiles[tileIndex].pixels[spriteY][spriteX];
                 if (colour == 0)
                     continue; // Transparent pixel.
 
@@ -359,10 +503,11 @@ namespace gasyboy
                 if (sprite.options.renderPriority && rowPixels[pixelX])
                     continue;
 
-                int pixelOffset = *LY * SCREEN_WIDTH + pixelX;
+                int pixelOffset = state.ly * SCREEN_WIDTH + pixelX;
                 if (sprite.colourPalette && pixelOffset >= 0 && pixelOffset < SCREEN_WIDTH * SCREEN_HEIGHT)
                 {
-                    _framebuffer[pixelOffset] = sprite.colourPalette[colour];
+                    framebuffer[pixelOffset] = palette[colour];
+                    shadebuffer[pixelOffset] = (paletteValue >> (colour * 2)) & 3;
                     // Record the x coordinate of the sprite that drew this pixel.
                     spriteXPriority[pixelX] = sprite.x;
                 }
@@ -373,6 +518,11 @@ namespace gasyboy
 
     void Ppu::refresh()
     {
+        // Don't let a frame still being drawn by the worker overwrite this one
+        finishRendering();
+
+        std::lock_guard<std::mutex> lock(_framebufferMutex);
+
         auto ly = *LY;
         *LY = 0;
 
@@ -385,12 +535,66 @@ namespace gasyboy
         *LY = ly;
     }
 
+    void Ppu::saveState(StateWriter &writer)
+    {
+        // A counting pass only wants the size, the render worker can keep going
+        const bool flush = !writer.isCounting();
+        const bool threaded = isThreadedRendering();
+        if (flush)
+        {
+            setThreadedRendering(false);
+        }
+
+        writer.write32(static_cast<uint32_t>(_modeClock));
+        writer.write32(static_cast<uint32_t>(windowLineCounter));
+        writer.writeBool(_canRender);
+        {
+            std::lock_guard<std::mutex> lock(_framebufferMutex);
+            writer.writeBytes(_framebuffer, sizeof(_framebuffer));
+            writer.writeBytes(_shadebuffer, sizeof(_shadebuffer));
+        }
+
+        if (flush)
+        {
+            setThreadedRendering(threaded);
+        }
+    }
+
+    void Ppu::loadState(StateReader &reader)
+    {
+        // The render worker restarts from the loaded video memory
+        const bool threaded = isThreadedRendering();
+        setThreadedRendering(false);
+
+        _modeClock = static_cast<int>(reader.read32());
+        windowLineCounter = static_cast<int>(reader.read32());
+        _canRender = reader.readBool();
+        {
+            std::lock_guard<std::mutex> lock(_framebufferMutex);
+            reader.readBytes(_framebuffer, sizeof(_framebuffer));
+            reader.readBytes(_shadebuffer, sizeof(_shadebuffer));
+        }
+
+        setThreadedRendering(threaded);
+    }
+
     void Ppu::reset()
     {
-        LCDC = (Control *)&_mmu->_memory[0xff40];
-        STAT = (Stat *)&_mmu->_memory[0xff41];
-        SCY = &_mmu->_memory[0xff42];
-        SCX = &_mmu->_memory[0xff43];
-        LY = &_mmu->_memory[0xff44];
+        // The render worker restarts from the reset video memory
+        setThreadedRendering(false);
+
+        LCDC = (Control *)&_mmu._memory[0xff40];
+        STAT = (Stat *)&_mmu._memory[0xff41];
+        SCY = &_mmu._memory[0xff42];
+        SCX = &_mmu._memory[0xff43];
+        LY = &_mmu._memory[0xff44];
+
+        windowLineCounter = 0;
+        _modeClock = 0;
+        _canRender = false;
+        _frameCount = 0;
+        _debugRender = false;
+
+        setThreadedRendering(_utilities.threadedPpu);
     }
 }
@@ -1,30 +1,92 @@
 #ifndef _PPU_H_
 #define _PPU_H_
 
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <array>
+#include <vector>
 #include "interruptManager.h"
 #include "registers.h"
+#include "utilities.h"
 #include "mmu.h"
 
 namespace gasyboy
 {
+    class PpuRenderWorker;
+
+    // PPU registers latched at the moment a scanline is drawn
+    struct ScanlineState
+    {
+        uint8_t ly;
+        uint8_t lcdc;
+        uint8_t scx;
+        uint8_t scy;
+        uint8_t wx;
+        uint8_t wy;
+        Colour bgp[4];
+        Colour obp0[4];
+        Colour obp1[4];
+
+        // Raw BGP/OBP0/OBP1, two bits per colour index give its DMG shade
+        uint8_t bgpValue;
+        uint8_t obp0Value;
+        uint8_t obp1Value;
+
+        // Number of VRAM/OAM writes logged before this scanline was drawn
+        uint32_t videoWriteCount;
+    };
+
+    // Video memory a scanline is drawn from
+    struct ScanlineSource
+    {
+        const uint8_t *vram; // 0x8000-0x9FFF
+        const Mmu::Tile *tiles;
+        const Mmu::Sprite *sprites;
+    };
+
+    // Everything the emulation thread records for one frame when rendering is deferred
+    struct FrameRecord
+    {
+        // LY is an 8 bit counter, a frame never records more than 256 scanlines
+        std::array<ScanlineState, 256> lines;
+        size_t lineCount = 0;
+        std::vector<VideoWrite> videoWrites;
+
+        void clear();
+    };
+
     class Ppu
     {
         void renderScanLines();
-        void renderScanLineBackground(bool *rowPixels);
-        void renderScanLineWindow(bool *rowPixels);
-        void renderScanLineSprites(bool *rowPixels);
+        void recordScanLine();
+        void submitFrameRecord();
+
+        // The deferred renderer, when threaded rendering is enabled
+        std::unique_ptr<PpuRenderWorker> _renderWorker;
+
+        // Scanlines recorded so far for the current frame
+        FrameRecord _frameRecord;
+
+        // Called when a frame is complete, on entering VBlank
+        std::function<void()> _vblankHandler;
 
     public:
-        Ppu();
+        Ppu(Mmu &mmu, Registers &registers, InterruptManager &interruptManager, Utilities &utilities);
+        ~Ppu();
         Ppu &operator=(const Ppu &);
 
-        std::shared_ptr<Registers> _registers;
-        std::shared_ptr<Mmu> _mmu;
-        std::shared_ptr<InterruptManager> _interruptManager;
+        Registers &_registers;
+        Mmu &_mmu;
+        InterruptManager &_interruptManager;
+        Utilities &_utilities;
 
         void reset();
 
+        // Save state, a threaded renderer is flushed first so the window line counter is settled
+        void saveState(StateWriter &writer);
+        void loadState(StateReader &reader);
+
         uint8_t *SCX;
         uint8_t *SCY;
         uint8_t *WX;
@@ -55,6 +117,7 @@ namespace gasyboy
                     uint8_t windowDisplaySelect : 1;
                     uint8_t lcdEnable : 1;
                 };
+                uint8_t value;
             };
         } *LCDC;
 
@@ -76,21 +139,54 @@ namespace gasyboy
 
         Colour _framebuffer[160 * 144];
 
+        // DMG shade of every framebuffer pixel, 0 (lightest) to 3, whatever the display colours
+        uint8_t _shadebuffer[160 * 144];
+
+        // Guards _framebuffer when frames are published by the render worker
+        std::mutex _framebufferMutex;
+
         int windowLineCounter = 0;
 
         int _modeClock = 0;
 
         bool _canRender = false;
 
+        // Frames completed since the last reset, not part of the save state
+        uint64_t _frameCount = 0;
+
         bool _debugRender = false;
 
         void step(const int &cycle);
 
+        // Cycles left before the next mode change, INT_MAX with the LCD off
+        int cyclesToNextMode();
+
         void setMode(PpuMode mode);
 
         void updateLY();
 
         void refresh();
+
+        // Move scanline rendering to a worker thread replaying per-scanline records
+        void setThreadedRendering(const bool &enabled);
+        bool isThreadedRendering();
+
+        // Wait until the worker has drawn every frame submitted so far
+        void finishRendering();
+
+        // Notified of every complete frame, the framebuffer is only final then with inline rendering
+        void setVBlankHandler(const std::function<void()> &handler);
+
+        // Latch the current registers into a scanline state
+        ScanlineState captureScanlineState();
+
+        // Draw one scanline from a latched state, shared by the inline and deferred paths
+        static void drawScanLine(const ScanlineState &state, const ScanlineSource &source, int &windowLineCounter, Colour *framebuffer, uint8_t *shadebuffer);
+
+    private:
+        static void renderScanLineBackground(const ScanlineState &state, const ScanlineSource &source, bool *rowPixels, Colour *framebuffer, uint8_t *shadebuffer);
+        static void renderScanLineWindow(const ScanlineState &state, const ScanlineSource &source, bool *rowPixels, int &windowLineCounter, Colour *framebuffer, uint8_t *shadebuffer);
+        static void renderScanLineSprites(const ScanlineState &state, const ScanlineSource &source, bool *rowPixels, Colour *framebuffer, uint8_t *shadebuffer);
     };
 }
 
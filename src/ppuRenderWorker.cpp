@@ -0,0 +1,162 @@
+#include "ppuRenderWorker.h"
+#include "profiler.h"
+#include <algorithm>
+
+namespace gasyboy
+{
+    PpuRenderWorker::PpuRenderWorker(Colour *output, uint8_t *shadeOutput, std::mutex &outputMutex)
+        : _vram(0x2000, 0),
+          _windowLineCounter(0),
+          _output(output),
+          _shadeOutput(shadeOutput),
+          _outputMutex(outputMutex),
+          _hasPending(false),
+          _busy(false),
+          _stop(false)
+    {
+        _thread = std::thread(&PpuRenderWorker::run, this);
+    }
+
+    PpuRenderWorker::~PpuRenderWorker()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _condition.notify_all();
+
+        if (_thread.joinable())
+        {
+            _thread.join();
+        }
+    }
+
+    void PpuRenderWorker::synchronize(Mmu &mmu, const int &windowLineCounter)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        std::copy(mmu._memory.begin() + 0x8000, mmu._memory.begin() + 0xA000, _vram.begin());
+        std::copy(mmu.tiles, mmu.tiles + 384, _tiles);
+        std::copy(mmu.sprites, mmu.sprites + 40, _sprites);
+        std::copy(mmu.palette_OBP0, mmu.palette_OBP0 + 4, _obp0);
+        std::copy(mmu.palette_OBP1, mmu.palette_OBP1 + 4, _obp1);
+
+        // Sprites must not point to the MMU palettes
+        for (auto &sprite : _sprites)
+        {
+            if (sprite.colourPalette)
+            {
+                sprite.colourPalette = sprite.options.paletteNumber ? _obp1 : _obp0;
+            }
+        }
+
+        _windowLineCounter = windowLineCounter;
+
+        // Scanlines that are not redrawn keep what is currently displayed
+        std::lock_guard<std::mutex> outputLock(_outputMutex);
+        std::copy(_output, _output + 160 * 144, _frame);
+        std::copy(_shadeOutput, _shadeOutput + 160 * 144, _frameShades);
+    }
+
+    void PpuRenderWorker::submit(FrameRecord &record)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this]()
+                            { return !_hasPending; });
+
+            std::swap(_pending, record);
+            _hasPending = true;
+        }
+        _condition.notify_all();
+    }
+
+    void PpuRenderWorker::wait()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condition.wait(lock, [this]()
+                        { return !_hasPending && !_busy; });
+    }
+
+    int PpuRenderWorker::getWindowLineCounter()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _windowLineCounter;
+    }
+
+    void PpuRenderWorker::run()
+    {
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _condition.wait(lock, [this]()
+                                { return _hasPending || _stop; });
+
+                if (!_hasPending)
+                    return;
+
+                // Take the frame and free the slot so the next one can be queued while drawing
+                std::swap(_pending, _current);
+                _hasPending = false;
+                _busy = true;
+            }
+            _condition.notify_all();
+
+            renderFrame();
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _busy = false;
+            }
+            _condition.notify_all();
+        }
+    }
+
+    void PpuRenderWorker::renderFrame()
+    {
+        GASYBOY_PROFILE_SCOPE("PpuRenderWorker::renderFrame");
+
+        const ScanlineSource source = {_vram.data(), _tiles, _sprites};
+
+        size_t applied = 0;
+        for (size_t line = 0; line < _current.lineCount; line++)
+        {
+            const ScanlineState &state = _current.lines[line];
+
+            // Replay the VRAM/OAM writes that happened before this scanline
+            for (; applied < state.videoWriteCount; applied++)
+            {
+                applyVideoWrite(_current.videoWrites[applied]);
+            }
+
+            Ppu::drawScanLine(state, source, _windowLineCounter, _frame, _frameShades);
+        }
+
+        // Writes done during VBlank belong to the next frame's video memory
+        for (; applied < _current.videoWrites.size(); applied++)
+        {
+            applyVideoWrite(_current.videoWrites[applied]);
+        }
+
+        std::lock_guard<std::mutex> lock(_outputMutex);
+        std::copy(_frame, _frame + 160 * 144, _output);
+        std::copy(_frameShades, _frameShades + 160 * 144, _shadeOutput);
+    }
+
+    void PpuRenderWorker::applyVideoWrite(const VideoWrite &write)
+    {
+        if (write.address < 0xA000)
+        {
+            _vram[write.address - 0x8000] = write.value;
+            if (write.address < 0x9800)
+            {
+                Mmu::decodeTile(_tiles, _vram.data(), write.address);
+            }
+        }
+        else
+        {
+            Mmu::decodeSprite(_sprites, write.address, write.value, _obp0, _obp1);
+        }
+    }
+}
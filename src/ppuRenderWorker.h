@@ -0,0 +1,70 @@
+#ifndef _PPU_RENDER_WORKER_H_
+#define _PPU_RENDER_WORKER_H_
+
+#include <condition_variable>
+#include <thread>
+#include <mutex>
+#include "ppu.h"
+
+namespace gasyboy
+{
+    // Draws frames recorded by the PPU on its own thread.
+    // It keeps a private copy of VRAM/OAM that follows the recorded write log,
+    // so each scanline sees video memory exactly as it was when it was recorded.
+    class PpuRenderWorker
+    {
+        // Private copy of video memory
+        std::vector<uint8_t> _vram;
+        Mmu::Tile _tiles[384];
+        Mmu::Sprite _sprites[40];
+        Colour _obp0[4];
+        Colour _obp1[4];
+        int _windowLineCounter;
+
+        // Frame being drawn
+        Colour _frame[160 * 144];
+        uint8_t _frameShades[160 * 144];
+
+        // Where finished frames are published
+        Colour *_output;
+        uint8_t *_shadeOutput;
+        std::mutex &_outputMutex;
+
+        // Frame handed over by the emulation thread and frame being drawn
+        FrameRecord _pending;
+        FrameRecord _current;
+        bool _hasPending;
+        bool _busy;
+        bool _stop;
+
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        std::thread _thread;
+
+        void run();
+        void renderFrame();
+        void applyVideoWrite(const VideoWrite &write);
+
+    public:
+        PpuRenderWorker(Colour *output, uint8_t *shadeOutput, std::mutex &outputMutex);
+        ~PpuRenderWorker();
+
+        PpuRenderWorker(const PpuRenderWorker &) = delete;
+        PpuRenderWorker &operator=(const PpuRenderWorker &) = delete;
+
+        // Copy the current video memory, must be called while the worker is idle
+        void synchronize(Mmu &mmu, const int &windowLineCounter);
+
+        // Queue a recorded frame, blocks while the previous one is still waiting to be drawn.
+        // The record is swapped with an old one so its buffers get reused.
+        void submit(FrameRecord &record);
+
+        // Wait until every submitted frame is drawn
+        void wait();
+
+        // Window line counter after the last drawn scanline
+        int getWindowLineCounter();
+    };
+}
+
+#endif
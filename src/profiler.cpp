@@ -0,0 +1,232 @@
+#include "profiler.h"
+#include "logger.h"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define PROFILER_RDTSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROFILER_RDTSC
+#endif
+
+namespace gasyboy
+{
+    namespace utils
+    {
+        namespace
+        {
+            int64_t wallNanoseconds()
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            }
+        }
+
+        Profiler::ThreadTree::ThreadTree()
+            : nodes(1, Node{"", 0, 0, 0, 0, 0}),
+              current(0),
+              tid(Profiler::getInstance()->_threadCount.fetch_add(1, std::memory_order_relaxed) + 1),
+              frame(0),
+              frameStart(0)
+        {
+        }
+
+        Profiler::ThreadTree::~ThreadTree()
+        {
+            // Threads ending mid-recording, like the PPU worker, hand over what they have
+            if (current == 0)
+            {
+                Profiler::getInstance()->submit(*this);
+            }
+        }
+
+        Profiler::Profiler()
+            : _frame(0),
+              _threadCount(0),
+              _startTicks(0),
+              _startNanoseconds(0)
+        {
+        }
+
+        Profiler *Profiler::getInstance()
+        {
+            // Never destroyed, threads ending at exit still hand their trees over
+            static Profiler *instance = new Profiler();
+            return instance;
+        }
+
+        Profiler::ThreadTree &Profiler::threadTree()
+        {
+            thread_local ThreadTree tree;
+            return tree;
+        }
+
+        uint64_t Profiler::now()
+        {
+#ifdef PROFILER_RDTSC
+            return __rdtsc();
+#else
+            return static_cast<uint64_t>(wallNanoseconds());
+#endif
+        }
+
+        void Profiler::start(const std::string &path)
+        {
+            static std::once_flag atExit;
+            std::call_once(atExit, []
+                           { std::atexit([]
+                                         { getInstance()->stop(); }); });
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _path = path;
+            _events.clear();
+            _startNanoseconds = wallNanoseconds();
+            _startTicks = now();
+            _recording = true;
+
+            Logger::getInstance()->log<Logger::LogType::INFO>("Profiling to ", path);
+        }
+
+        bool Profiler::stop()
+        {
+            if (!isRecording())
+            {
+                return true;
+            }
+
+            // Other threads are mid-frame, at most their last frame is missing
+            ThreadTree &tree = threadTree();
+            if (tree.current == 0)
+            {
+                submit(tree);
+            }
+
+            if (!_recording.exchange(false))
+            {
+                return true;
+            }
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            return write();
+        }
+
+        void Profiler::nextFrame()
+        {
+            _frame.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void Profiler::enter(const char *name)
+        {
+            ThreadTree &tree = threadTree();
+            const uint64_t ticks = now();
+
+            if (tree.nodes.size() == 1)
+            {
+                tree.frame = _frame.load(std::memory_order_relaxed);
+                tree.frameStart = ticks;
+            }
+
+            // Names are literals, the same scope always comes with the same pointer
+            uint32_t child = tree.nodes[tree.current].firstChild;
+            while (child != 0 && tree.nodes[child].name != name)
+            {
+                child = tree.nodes[child].nextSibling;
+            }
+
+            if (child == 0)
+            {
+                child = static_cast<uint32_t>(tree.nodes.size());
+                Node &parent = tree.nodes[tree.current];
+                const uint32_t sibling = parent.firstChild;
+                parent.firstChild = child;
+                tree.nodes.push_back(Node{name, tree.current, 0, sibling, 0, 0});
+            }
+
+            tree.current = child;
+            tree.starts.push_back(ticks);
+        }
+
+        void Profiler::leave()
+        {
+            ThreadTree &tree = threadTree();
+            Node &node = tree.nodes[tree.current];
+            node.ticks += now() - tree.starts.back();
+            node.calls++;
+            tree.starts.pop_back();
+            tree.current = node.parent;
+
+            // Back at the top of the stack past a frame boundary, the tree is complete
+            if (tree.current == 0 && tree.frame != _frame.load(std::memory_order_relaxed))
+            {
+                submit(tree);
+            }
+        }
+
+        void Profiler::submit(ThreadTree &tree)
+        {
+            if (tree.nodes.size() > 1 && _recording.load(std::memory_order_relaxed))
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (tree.frameStart >= _startTicks)
+                {
+                    addEvents(tree, 0, tree.frameStart - _startTicks);
+                }
+            }
+
+            tree.nodes.resize(1);
+            tree.nodes[0].firstChild = 0;
+        }
+
+        uint64_t Profiler::addEvents(const ThreadTree &tree, const uint32_t &parent, uint64_t start)
+        {
+            // Children are linked newest first, they are laid out in the order they were first called
+            std::vector<uint32_t> children;
+            for (uint32_t child = tree.nodes[parent].firstChild; child != 0; child = tree.nodes[child].nextSibling)
+            {
+                children.push_back(child);
+            }
+
+            uint64_t ticks = 0;
+            for (auto child = children.rbegin(); child != children.rend(); ++child)
+            {
+                const Node &node = tree.nodes[*child];
+                _events.push_back({node.name, start + ticks, node.ticks, node.calls, tree.tid});
+                addEvents(tree, *child, start + ticks);
+                ticks += node.ticks;
+            }
+            return ticks;
+        }
+
+        bool Profiler::write()
+        {
+            std::ofstream file(_path);
+            if (!file.is_open())
+            {
+                Logger::getInstance()->log(Logger::LogType::CRITICAL, "Unable to write profile to " + _path);
+                return false;
+            }
+
+            const uint64_t ticks = now() - _startTicks;
+            const double microsecondsPerTick = ticks > 0 ? (wallNanoseconds() - _startNanoseconds) / 1000.0 / ticks : 0;
+
+            file << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+            for (size_t i = 0; i < _events.size(); i++)
+            {
+                const Event &event = _events[i];
+                file << (i > 0 ? ",\n" : "\n")
+                     << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.tid
+                     << ",\"ts\":" << event.start * microsecondsPerTick
+                     << ",\"dur\":" << event.ticks * microsecondsPerTick
+                     << ",\"args\":{\"calls\":" << event.calls << "}}";
+            }
+            file << "\n]}\n";
+
+            Logger::getInstance()->log<Logger::LogType::INFO>("Profile written to ", _path, ": ", _events.size(), " events");
+            _events.clear();
+            return true;
+        }
+    }
+}
@@ -0,0 +1,154 @@
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Scoped timers are only compiled in with GASYBOY_PROFILER, they cost nothing otherwise
+#ifdef GASYBOY_PROFILER
+#define GASYBOY_PROFILE_CONCAT_(a, b) a##b
+#define GASYBOY_PROFILE_CONCAT(a, b) GASYBOY_PROFILE_CONCAT_(a, b)
+#define GASYBOY_PROFILE_SCOPE(name) gasyboy::utils::ProfileScope GASYBOY_PROFILE_CONCAT(_profileScope, __LINE__)(name)
+#define GASYBOY_PROFILE_FRAME() gasyboy::utils::Profiler::getInstance()->nextFrame()
+#else
+#define GASYBOY_PROFILE_SCOPE(name) ((void)0)
+#define GASYBOY_PROFILE_FRAME() ((void)0)
+#endif
+
+namespace gasyboy
+{
+    namespace utils
+    {
+        // Hierarchical profiler. Each thread adds its scopes to its own call tree, calls of the same scope
+        // under the same parent are merged, and the tree is handed over once per emulated frame. The
+        // trees are written as Chrome trace_event JSON (chrome://tracing, Perfetto): one event per scope
+        // and frame, laid out back to back inside its parent, with the number of calls as argument.
+        class Profiler
+        {
+        public:
+            // Whether the scoped timers were compiled in
+#ifdef GASYBOY_PROFILER
+            static constexpr bool AVAILABLE = true;
+#else
+            static constexpr bool AVAILABLE = false;
+#endif
+
+            // Get profiler instance, it lives until the process exits
+            static Profiler *getInstance();
+
+            // Start recording, the trace is written to path by stop() or at exit
+            void start(const std::string &path);
+
+            // Stop recording and write the trace, false when it could not be written
+            bool stop();
+
+            // Checked by every scope, kept out of the instance so it is a single load
+            static bool isRecording()
+            {
+                return _recording.load(std::memory_order_relaxed);
+            }
+
+            // Frame boundary, the call trees of every thread are handed over after it
+            void nextFrame();
+
+            // Called by ProfileScope on the current thread
+            void enter(const char *name);
+            void leave();
+
+            // rdtsc on x86, steady clock elsewhere
+            static uint64_t now();
+
+        private:
+            Profiler();
+            ~Profiler() = default;
+
+            // Scope of a call tree, calls with the same name under the same parent share one
+            struct Node
+            {
+                const char *name;
+                uint32_t parent;
+                uint32_t firstChild;
+                uint32_t nextSibling;
+                uint64_t ticks;
+                uint32_t calls;
+            };
+
+            struct ThreadTree
+            {
+                ThreadTree();
+                ~ThreadTree();
+
+                // Node 0 is the root, the thread itself
+                std::vector<Node> nodes;
+                std::vector<uint64_t> starts;
+                uint32_t current;
+                uint32_t tid;
+                uint64_t frame;
+                uint64_t frameStart;
+            };
+
+            // A scope over one frame of one thread, ticks relative to the recording start
+            struct Event
+            {
+                const char *name;
+                uint64_t start;
+                uint64_t ticks;
+                uint32_t calls;
+                uint32_t tid;
+            };
+
+            static ThreadTree &threadTree();
+
+            // Turn the tree into events and clear it, lays children out from start
+            void submit(ThreadTree &tree);
+            uint64_t addEvents(const ThreadTree &tree, const uint32_t &parent, uint64_t start);
+
+            bool write();
+
+            static inline std::atomic<bool> _recording = false;
+            std::atomic<uint64_t> _frame;
+            std::atomic<uint32_t> _threadCount;
+
+            std::mutex _mutex;
+            std::string _path;
+            std::vector<Event> _events;
+
+            // Ticks and wall time at start, to convert ticks to microseconds
+            uint64_t _startTicks;
+            int64_t _startNanoseconds;
+        };
+
+        // Times the enclosing scope, use GASYBOY_PROFILE_SCOPE so it compiles out
+        class ProfileScope
+        {
+        public:
+            explicit ProfileScope(const char *name)
+                : _active(Profiler::isRecording())
+            {
+                if (_active)
+                {
+                    Profiler::getInstance()->enter(name);
+                }
+            }
+
+            ~ProfileScope()
+            {
+                if (_active)
+                {
+                    Profiler::getInstance()->leave();
+                }
+            }
+
+            ProfileScope(const ProfileScope &) = delete;
+            ProfileScope &operator=(const ProfileScope &) = delete;
+
+        private:
+            bool _active;
+        };
+    }
+}
+
+#endif
@@ -1,5 +1,7 @@
 #include "gameBoyProvider.h"
 #include "utilitiesProvider.h"
+#include "sdlInputHandler.h"
+#include "renderer.h"
 
 namespace gasyboy
 {
@@ -170,12 +172,13 @@ namespace gasyboy
             {
                 if (utilities->romFilePath.empty())
                 {
-                    _gameboyInstance = std::make_shared<GameBoy>(_tetrisBytes.data(), _tetrisBytes.size());
+                    _gameboyInstance = std::make_shared<GameBoy>(utilities, _tetrisBytes.data(), _tetrisBytes.size(),
+                                                                 std::make_unique<Renderer>(), std::make_unique<SdlInputHandler>());
                     std::cout << "Creating emulator with two parameters...\n";
                 }
                 else
                 {
-                    _gameboyInstance = std::make_shared<GameBoy>();
+                    _gameboyInstance = std::make_shared<GameBoy>(utilities, std::make_unique<Renderer>(), std::make_unique<SdlInputHandler>());
                     std::cout << "Creating emulator without parameters...\n";
                 }
             }
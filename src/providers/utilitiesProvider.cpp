@@ -10,15 +10,7 @@ namespace gasyboy
         {
             if (!_utilitiesInstance)
             {
-                Utilities utilities = {
-                    true,
-                    "",
-                    "",
-                    false,
-                    false,
-                    false,
-                };
-                _utilitiesInstance = std::make_shared<Utilities>(utilities);
+                _utilitiesInstance = std::make_shared<Utilities>();
             }
             return _utilitiesInstance;
         }
@@ -1,22 +1,12 @@
 #ifndef __UTILITIES_PROVIDER_H__
 #define __UTILITIES_PROVIDER_H__
 
-#include <string>
+#include "utilities.h"
 #include <memory>
 
 namespace gasyboy
 {
 
-    struct Utilities
-    {
-        bool executeBios;
-        std::string romFilePath;
-        std::string newRomFilePath;
-        bool debugMode;
-        bool wasReset;
-        bool wasRefreshed;
-    };
-
     namespace provider
     {
         class UtilitiesProvider
@@ -3,6 +3,7 @@
 #include "logger.h"
 #include "defs.h"
 #include <iostream>
+#include <sstream>
 
 namespace gasyboy
 {
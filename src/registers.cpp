@@ -1,5 +1,3 @@
-#include "utilitiesProvider.h"
-#include "mmuProvider.h"
 #include "gbException.h"
 #include "registers.h"
 #include "logger.h"
@@ -7,8 +5,9 @@
 
 namespace gasyboy
 {
-    Registers::Registers()
-        : _mmu(provider::MmuProvider::getInstance()),
+    Registers::Registers(Mmu &mmu, Utilities &utilities)
+        : _mmu(mmu),
+          _utilities(utilities),
           AF(0),
           BC(0),
           DE(0),
@@ -18,7 +17,7 @@ namespace gasyboy
           _interruptEnabled(false),
           _halted(false),
           _stopMode(false),
-          _executeBios(provider::UtilitiesProvider::getInstance()->executeBios)
+          _executeBios(utilities.executeBios)
     {
         if (!_executeBios)
         {
@@ -63,6 +62,8 @@ namespace gasyboy
         SP = 0;
         _interruptEnabled = false;
         _halted = false;
+        _stopMode = false;
+        _executeBios = _utilities.executeBios;
 
         if (!_executeBios)
         {
@@ -82,6 +83,32 @@ namespace gasyboy
         }
     }
 
+    void Registers::saveState(StateWriter &writer)
+    {
+        writer.write16(AF.get());
+        writer.write16(BC.get());
+        writer.write16(DE.get());
+        writer.write16(HL.get());
+        writer.write16(PC);
+        writer.write16(SP);
+        writer.writeBool(_interruptEnabled);
+        writer.writeBool(_halted);
+        writer.writeBool(_stopMode);
+    }
+
+    void Registers::loadState(StateReader &reader)
+    {
+        AF.set(reader.read16());
+        BC.set(reader.read16());
+        DE.set(reader.read16());
+        HL.set(reader.read16());
+        PC = reader.read16();
+        SP = reader.read16();
+        _interruptEnabled = reader.readBool();
+        _halted = reader.readBool();
+        _stopMode = reader.readBool();
+    }
+
     Register Registers::getRegister(const Register::RegisterPairName &reg)
     {
         try
@@ -190,9 +217,9 @@ namespace gasyboy
         uint8_t secondByte = static_cast<uint8_t>(address & 0xFF);
 
         SP--;
-        _mmu->writeRam(SP, firstByte);
+        _mmu.writeRam(SP, firstByte);
         SP--;
-        _mmu->writeRam(SP, secondByte);
+        _mmu.writeRam(SP, secondByte);
     }
 
     void Registers::setInterruptEnabled(const bool &value)
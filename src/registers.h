@@ -3,6 +3,8 @@
 
 #include "register.h"
 #include "mmu.h"
+#include "utilities.h"
+#include "saveState.h"
 #include <map>
 #include <memory>
 
@@ -10,7 +12,10 @@ namespace gasyboy
 {
     class Registers
     {
-        std::shared_ptr<Mmu> _mmu;
+        Mmu &_mmu;
+
+        // Emulator settings
+        Utilities &_utilities;
 
         std::map<Register::RegisterPairName, Register> _registersMap;
 
@@ -28,12 +33,16 @@ namespace gasyboy
 
     public:
         // Constructors
-        Registers();
+        Registers(Mmu &mmu, Utilities &utilities);
         Registers &operator=(const Registers &);
 
         // Reset registers
         void reset();
 
+        // Save state
+        void saveState(StateWriter &writer);
+        void loadState(StateReader &reader);
+
         // Get the corresponding register
         Register getRegister(const Register::RegisterPairName &reg);
         uint8_t getRegister(const Register::RegisterName &reg);
@@ -1,9 +1,8 @@
-#include "interruptManagerProvider.h"
-#include "registersProvider.h"
-#include "cpuProvider.h"
-#include "mmuProvider.h"
-#include "ppuProvider.h"
 #include "renderer.h"
+#include "gameboy.h"
+#include "logger.h"
+#include "profiler.h"
+#include "utils.h"
 
 #ifndef EMSCRIPTEN
 #include <SDL_syswm.h>
@@ -12,16 +11,24 @@
 namespace gasyboy
 {
     Renderer::Renderer()
-        : _cpu(provider::CpuProvider::getInstance()),
-          _ppu(provider::PpuProvider::getInstance()),
-          _registers(provider::RegistersProvider::getInstance()),
-          _interruptManager(provider::InterruptManagerProvider::getInstance()),
-          _mmu(provider::MmuProvider::getInstance())
+        : _window(nullptr),
+          _renderer(nullptr),
+          _viewportTexture(nullptr),
+          _gameboy(nullptr),
+          _ppu(nullptr)
     {
     }
 
     Renderer::~Renderer()
     {
+#ifndef EMSCRIPTEN
+        // The debugger goes before the window it is attached to
+        _debugger.reset();
+#endif
+
+        // The device callback stops before the ring goes
+        _audio.reset();
+
         // Destroy viewport texture if allocated
         if (_viewportTexture)
         {
@@ -44,13 +51,15 @@ namespace gasyboy
         }
     }
 
-    void Renderer::init()
+    void Renderer::init(GameBoy &gameboy)
     {
-        // Fill pixels to white
-        _viewportPixels.fill(0xFF);
+        // Created before the core, attach to it now that it exists
+        _gameboy = &gameboy;
+        _ppu = &gameboy.getPpu();
 
         // Iniy SDL and _window
         initWindow(_windowWidth, _windowHeight);
+        initAudio();
 
         // Create viewport texture
         _viewportTexture = SDL_CreateTexture(_renderer,
@@ -77,38 +86,113 @@ namespace gasyboy
         {
             SDL_Log("Could not get window information: %s", SDL_GetError());
         }
+
+        if (_gameboy->getUtilities().debugMode)
+        {
+            _debugger = std::make_shared<Debugger>(_window, gameboy);
+        }
 #endif
     }
 
+    void Renderer::initAudio()
+    {
+        _audio = std::make_unique<SdlAudio>(Apu::DEFAULT_SAMPLE_RATE);
+        if (!_audio->isOpen())
+        {
+            return;
+        }
+
+        auto &apu = _gameboy->getApu();
+        apu.setSampleRate(_audio->getSampleRate());
+
+        // Fast-forward is silent, the ring would only keep scraps of it
+        apu.setSampleHandler([this](const int16_t *samples, const size_t &frames)
+                             {
+            if (_gameboy->getSpeed() == 1)
+            {
+                _audio->push(samples, frames);
+            } });
+    }
+
     void Renderer::initWindow(int windowWidth, int windowHeight)
     {
         SDL_Init(SDL_INIT_VIDEO);
 
+        const bool vsync = _gameboy->getUtilities().vsync;
+        SDL_SetHint(SDL_HINT_RENDER_VSYNC, vsync ? "1" : "0");
+
         SDL_CreateWindowAndRenderer(windowWidth * 2, windowHeight * 2, 0, &_window, &_renderer);
         SDL_SetWindowPosition(_window, 20, 50);
         SDL_RenderSetLogicalSize(_renderer, windowWidth, windowHeight);
         SDL_SetWindowResizable(_window, SDL_TRUE);
         SDL_SetWindowTitle(_window, "GasyBoy");
+
+        // With vsync on a display close enough to the DMG rate, presenting already paces the frames
+        _displayPaced = false;
+        SDL_DisplayMode displayMode;
+        if (vsync && SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(_window), &displayMode) == 0)
+        {
+            _displayPaced = std::abs(displayMode.refresh_rate - DMG_FRAME_RATE) < 1.0;
+
+            utils::Logger::getInstance()->log(utils::Logger::LogType::FUNCTIONAL,
+                                              "Display refresh rate: " + std::to_string(displayMode.refresh_rate) +
+                                                  " Hz, paced by vsync: " + (_displayPaced ? "true" : "false"));
+        }
     }
 
-    void Renderer::checkFramerate()
+    void Renderer::renderDebugger()
     {
-        _endFrame = std::chrono::steady_clock::now();
-        auto timeTook = std::chrono::duration_cast<std::chrono::milliseconds>(_endFrame - _startFrame).count();
-
-        if (timeTook < _framerateTime)
+#ifndef EMSCRIPTEN
+        if (_debugger)
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(_framerateTime - timeTook));
+            _debugger->render();
         }
+#endif
+    }
 
-        _startFrame = std::chrono::steady_clock::now();
+    void Renderer::countEmulatedFrame()
+    {
+        _emulatedFrameCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool Renderer::isDisplayPaced()
+    {
+        return _displayPaced;
+    }
+
+    size_t Renderer::queuedAudioFrames()
+    {
+        return _audio && _audio->isOpen() ? _audio->queuedFrames() : 0;
+    }
+
+    size_t Renderer::audioCapacityFrames()
+    {
+        return _audio && _audio->isOpen() ? SdlAudio::capacityFrames() : 0;
     }
 
     void Renderer::render()
     {
-        // Framerate check
-        checkFramerate();
+        GASYBOY_PROFILE_SCOPE("Renderer::render");
+
+        beginFrame();
 
+        // Draw on viewport
+        draw();
+
+        endFrame();
+    }
+
+    void Renderer::render(const Colour *framebuffer)
+    {
+        GASYBOY_PROFILE_SCOPE("Renderer::render");
+
+        beginFrame();
+        upload(framebuffer);
+        endFrame();
+    }
+
+    void Renderer::beginFrame()
+    {
         ColorMode colorMode = ColorMode::NORMAL; // TODO: Make it dynamic
 
         switch (colorMode)
@@ -127,10 +211,10 @@ namespace gasyboy
         SDL_SetRenderDrawColor(_renderer, 255, 255, 255, 255);
         SDL_RenderClear(_renderer);
         SDL_SetRenderTarget(_renderer, _viewportTexture);
+    }
 
-        // Draw on viewport
-        draw();
-
+    void Renderer::endFrame()
+    {
         // Present
         SDL_RenderCopy(_renderer, _viewportTexture, NULL, &_viewportRect);
         SDL_RenderPresent(_renderer);
@@ -142,7 +226,12 @@ namespace gasyboy
 
         if (elapsed >= 1000) // Update every 1 second
         {
-            std::string title = "GasyBoy - FPS: " + std::to_string(_frameCount);
+            // Emulated frames against the DMG rate over the same second
+            const double emulatedRate = _emulatedFrameCount.exchange(0) * 1000.0 / elapsed;
+            const int speedPercent = static_cast<int>(std::lround(emulatedRate * 100.0 / DMG_FRAME_RATE));
+
+            std::string title = "GasyBoy - FPS: " + std::to_string(_frameCount) +
+                                " - Speed: " + std::to_string(speedPercent) + "%";
             SDL_SetWindowTitle(_window, title.c_str());
 
             _frameCount = 0;
@@ -152,12 +241,47 @@ namespace gasyboy
 
     void Renderer::draw()
     {
-        for (int i = 0; i < 144 * 160; i++)
+        std::lock_guard<std::mutex> lock(_ppu->_framebufferMutex);
+        upload(_ppu->_framebuffer);
+    }
+
+    void Renderer::upload(const Colour *framebuffer)
+    {
+        // Nothing to upload if the texture already holds this frame
+        const uint64_t frameHash = utils::hash64(framebuffer, sizeof(Colour) * _viewportWidth * _viewportHeight);
+        if (_viewportTextureValid && frameHash == _lastFrameHash)
+        {
+            return;
+        }
+
+        void *pixels = nullptr;
+        int pitch = 0;
+        if (SDL_LockTexture(_viewportTexture, NULL, &pixels, &pitch) != 0)
+        {
+            SDL_Log("Could not lock viewport texture: %s", SDL_GetError());
+            return;
+        }
+
+        // Resolve colours straight into the texture memory as packed ARGB8888
+        for (int y = 0; y < _viewportHeight; y++)
         {
-            Colour colour = _ppu->_framebuffer[i];
-            std::copy(colour.colours, colour.colours + 4, _viewportPixels.begin() + i * 4);
+            uint32_t *row = reinterpret_cast<uint32_t *>(static_cast<uint8_t *>(pixels) + y * pitch);
+            const Colour *colours = &framebuffer[y * _viewportWidth];
+
+            for (int x = 0; x < _viewportWidth; x++)
+            {
+                const Colour &colour = colours[x];
+                row[x] = (static_cast<uint32_t>(colour.a) << 24) |
+                         (static_cast<uint32_t>(colour.r) << 16) |
+                         (static_cast<uint32_t>(colour.g) << 8) |
+                         static_cast<uint32_t>(colour.b);
+            }
         }
-        SDL_UpdateTexture(_viewportTexture, NULL, _viewportPixels.data(), _viewportWidth * 4);
+
+        SDL_UnlockTexture(_viewportTexture);
+
+        _lastFrameHash = frameHash;
+        _viewportTextureValid = true;
     }
 
     void Renderer::reset()
@@ -166,12 +290,6 @@ namespace gasyboy
         _viewportWidth = 160;
         _viewportHeight = 144;
         _viewportRect = {0, 0, _viewportWidth, _viewportHeight};
-        _viewportPixels.fill(0);
-
-        // Reset framerate timing
-        _framerateTime = 1000 / 60;
-        _startFrame = std::chrono::steady_clock::now();
-        _endFrame = _startFrame;
 
         // Clear the renderer
         if (_renderer)
@@ -186,16 +304,15 @@ namespace gasyboy
             _viewportTexture = nullptr;
         }
 
-        // Resetting the CPU, PPU, and memory components (if needed)
-        _cpu = provider::CpuProvider::getInstance();
-        _ppu = provider::PpuProvider::getInstance();
-        _mmu = provider::MmuProvider::getInstance();
-        _interruptManager = provider::InterruptManagerProvider::getInstance();
-
-        // Fill pixels to white
-        _viewportPixels.fill(0xFF);
+#ifndef EMSCRIPTEN
+        if (_debugger)
+        {
+            _debugger->reset();
+        }
+#endif
 
-        // Recreate the viewport texture
+        // Recreate the viewport texture, its content has to be uploaded again
+        _viewportTextureValid = false;
         _viewportTexture = SDL_CreateTexture(_renderer,
                                              SDL_PIXELFORMAT_ARGB8888,
                                              SDL_TEXTUREACCESS_STREAMING,
@@ -4,11 +4,14 @@
 #else
 #include "SDL.h"
 #include "SDL_timer.h"
+#include "debugger.h"
 #endif
 
 #include <stdlib.h>
 #include <array>
+#include <atomic>
 #include <bitset>
+#include <cmath>
 #include <chrono>
 #include <iomanip>
 #include <iostream>
@@ -20,10 +23,13 @@
 #include "cpu.h"
 #include "mmu.h"
 #include "ppu.h"
+#include "frontend.h"
+#include "sdlAudio.h"
 
 namespace gasyboy
 {
-    class Renderer
+    // SDL presentation, with the ImGui debugger in debug mode
+    class Renderer : public IRenderer
     {
     public:
         SDL_Window *_window;
@@ -31,42 +37,73 @@ namespace gasyboy
 
         SDL_Texture *_viewportTexture;
 
-        std::shared_ptr<Cpu> _cpu;
-        std::shared_ptr<Ppu> _ppu;
-        std::shared_ptr<Registers> _registers;
-        std::shared_ptr<InterruptManager> _interruptManager;
-        std::shared_ptr<Mmu> _mmu;
+        // Instance this frontend is attached to
+        GameBoy *_gameboy;
+        Ppu *_ppu;
+
+#ifndef EMSCRIPTEN
+        std::shared_ptr<Debugger> _debugger;
+#endif
+
+        // Plays the APU output
+        std::unique_ptr<SdlAudio> _audio;
+
+        void initAudio();
 
         // Viewport
         int _viewportWidth = 160;
         int _viewportHeight = 144;
-        std::array<uint8_t, 160 * 144 * 4> _viewportPixels;
         SDL_Rect _viewportRect = {0, 0, _viewportWidth, _viewportHeight};
 
         int _windowHeight = _viewportHeight;
         int _windowWidth = _viewportWidth;
 
-        int _framerateTime = 1000 / 60;
-        std::chrono::steady_clock::time_point _startFrame;
-        std::chrono::steady_clock::time_point _endFrame;
-        void checkFramerate();
+        // Hash of the frame currently in the viewport texture, to skip uploading identical frames
+        uint64_t _lastFrameHash = 0;
+        bool _viewportTextureValid = false;
+
+        // Vsync is on and the display runs at the DMG rate, presenting paces the frames by itself
+        bool _displayPaced = false;
+
+        // Upload a frame into the viewport texture
+        void upload(const Colour *framebuffer);
+
+        void beginFrame();
+        void endFrame();
 
         void initWindow(int windowWidth, int windowHeight);
 
         int _frameCount = 0;
+
+        // Frames emulated since the last title update, presented or not
+        std::atomic<uint32_t> _emulatedFrameCount = 0;
         std::chrono::steady_clock::time_point _fpsTimerStart = std::chrono::steady_clock::now();
 
     public:
         Renderer();
         ~Renderer();
 
-        void render();
+        // Present the PPU framebuffer
+        void render() override;
+
+        // Present a frame handed over by the emulation thread
+        void render(const Colour *framebuffer) override;
+
+        void renderDebugger() override;
+
+        bool isDisplayPaced() override;
+
+        // Frames counted here give the speed shown in the title
+        void countEmulatedFrame() override;
+
+        size_t queuedAudioFrames() override;
+        size_t audioCapacityFrames() override;
 
-        virtual void init();
+        void init(GameBoy &gameboy) override;
 
         virtual void draw();
 
-        void reset();
+        void reset() override;
 
         void setWindowAlwaysOnTop();
 
@@ -0,0 +1,225 @@
+#include "rewindBuffer.h"
+#include <cstring>
+
+namespace gasyboy
+{
+    namespace
+    {
+        // Equal bytes shorter than this stay inside a differing run, a new triplet would cost more
+        constexpr size_t MIN_EQUAL_RUN = 4;
+
+        void writeVarint(std::vector<uint8_t> &out, size_t value)
+        {
+            while (value >= 0x80)
+            {
+                out.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        size_t readVarint(const uint8_t *&in)
+        {
+            size_t value = 0;
+            int shift = 0;
+            while (*in & 0x80)
+            {
+                value |= static_cast<size_t>(*in++ & 0x7F) << shift;
+                shift += 7;
+            }
+            return value | (static_cast<size_t>(*in++) << shift);
+        }
+    }
+
+    RewindBuffer::RewindBuffer(const size_t &stateSize, const size_t &capacity)
+        : _stateSize(stateSize),
+          _capacity(capacity < 2 ? 2 : capacity),
+          _latest(stateSize),
+          _hasLatest(false),
+          _deltaBytes(0),
+          _pending(stateSize),
+          _current(stateSize),
+          _hasPending(false),
+          _busy(false),
+          _stop(false)
+    {
+        _thread = std::thread(&RewindBuffer::run, this);
+    }
+
+    RewindBuffer::~RewindBuffer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _condition.notify_all();
+
+        if (_thread.joinable())
+        {
+            _thread.join();
+        }
+    }
+
+    void RewindBuffer::push(const uint8_t *state)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            std::memcpy(_pending.data(), state, _stateSize);
+            _hasPending = true;
+        }
+        _condition.notify_all();
+    }
+
+    bool RewindBuffer::pop(uint8_t *state)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condition.wait(lock, [this]()
+                        { return !_hasPending && !_busy; });
+
+        if (!_hasLatest)
+        {
+            return false;
+        }
+
+        std::memcpy(state, _latest.data(), _stateSize);
+
+        // The state before it becomes the newest one
+        if (!_deltas.empty())
+        {
+            applyDelta(_deltas.back(), _latest.data(), _stateSize);
+            _deltaBytes -= _deltas.back().size();
+            _deltas.pop_back();
+        }
+
+        return true;
+    }
+
+    size_t RewindBuffer::size()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _hasLatest ? _deltas.size() + 1 : 0;
+    }
+
+    size_t RewindBuffer::memoryUsage()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _deltaBytes;
+    }
+
+    void RewindBuffer::run()
+    {
+        std::vector<uint8_t> delta;
+
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _condition.wait(lock, [this]()
+                                { return _hasPending || _stop; });
+                if (_stop)
+                {
+                    return;
+                }
+
+                std::swap(_pending, _current);
+                _hasPending = false;
+                _busy = true;
+
+                if (!_hasLatest)
+                {
+                    std::swap(_latest, _current);
+                    _hasLatest = true;
+                    _busy = false;
+                    _condition.notify_all();
+                    continue;
+                }
+            }
+
+            // _latest only changes under the lock while the worker is idle, it can be read here
+            delta.clear();
+            encodeDelta(_current.data(), _latest.data(), _stateSize, delta);
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                std::swap(_latest, _current);
+
+                // Reuse the evicted delta's storage when the ring is full
+                std::vector<uint8_t> entry;
+                if (_deltas.size() + 1 >= _capacity && !_deltas.empty())
+                {
+                    entry = std::move(_deltas.front());
+                    _deltaBytes -= entry.size();
+                    _deltas.pop_front();
+                }
+                entry.assign(delta.begin(), delta.end());
+                _deltaBytes += entry.size();
+                _deltas.push_back(std::move(entry));
+
+                _busy = false;
+            }
+            _condition.notify_all();
+        }
+    }
+
+    void RewindBuffer::encodeDelta(const uint8_t *newer, const uint8_t *older, const size_t &size, std::vector<uint8_t> &out)
+    {
+        size_t i = 0;
+        while (i < size)
+        {
+            const size_t equalStart = i;
+            while (i < size && newer[i] == older[i])
+            {
+                i++;
+            }
+            if (i == size)
+            {
+                break;
+            }
+
+            const size_t diffStart = i;
+            while (i < size)
+            {
+                if (newer[i] != older[i])
+                {
+                    i++;
+                    continue;
+                }
+
+                size_t j = i;
+                while (j < size && j - i < MIN_EQUAL_RUN && newer[j] == older[j])
+                {
+                    j++;
+                }
+                if (j - i >= MIN_EQUAL_RUN || j == size)
+                {
+                    break;
+                }
+                i = j;
+            }
+
+            writeVarint(out, diffStart - equalStart);
+            writeVarint(out, i - diffStart);
+            for (size_t k = diffStart; k < i; k++)
+            {
+                out.push_back(newer[k] ^ older[k]);
+            }
+        }
+    }
+
+    void RewindBuffer::applyDelta(const std::vector<uint8_t> &delta, uint8_t *state, const size_t &size)
+    {
+        const uint8_t *in = delta.data();
+        const uint8_t *end = in + delta.size();
+        uint8_t *out = state;
+
+        while (in < end)
+        {
+            out += readVarint(in);
+            const size_t count = readVarint(in);
+            for (size_t k = 0; k < count && out < state + size; k++)
+            {
+                *out++ ^= *in++;
+            }
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef _REWIND_BUFFER_H_
+#define _REWIND_BUFFER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gasyboy
+{
+    // History of save states for rewinding.
+    // Only the newest state is kept whole, each older one is stored as the XOR of it and its successor,
+    // run-length encoded. Consecutive states mostly match, so these deltas are a few hundred bytes.
+    // Encoding happens on a worker thread, the emulation thread only copies the state in.
+    class RewindBuffer
+    {
+        size_t _stateSize;
+        size_t _capacity;
+
+        // Newest state, and the deltas leading back from it (oldest first)
+        std::vector<uint8_t> _latest;
+        bool _hasLatest;
+        std::deque<std::vector<uint8_t>> _deltas;
+        size_t _deltaBytes;
+
+        // State handed over by the emulation thread
+        std::vector<uint8_t> _pending;
+        std::vector<uint8_t> _current;
+        bool _hasPending;
+        bool _busy;
+        bool _stop;
+
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        std::thread _thread;
+
+        void run();
+
+        // RLE of the XOR of two states: (equal run, differing run, XORed bytes) triplets, lengths as varints
+        static void encodeDelta(const uint8_t *newer, const uint8_t *older, const size_t &size, std::vector<uint8_t> &out);
+        static void applyDelta(const std::vector<uint8_t> &delta, uint8_t *state, const size_t &size);
+
+    public:
+        // Keeps up to capacity states of stateSize bytes
+        RewindBuffer(const size_t &stateSize, const size_t &capacity);
+        ~RewindBuffer();
+
+        RewindBuffer(const RewindBuffer &) = delete;
+        RewindBuffer &operator=(const RewindBuffer &) = delete;
+
+        // Queue a state, a snapshot still waiting to be encoded is replaced
+        void push(const uint8_t *state);
+
+        // Take the newest state out into state. The oldest one is never taken out,
+        // so holding rewind stops there. Returns false when nothing was pushed yet.
+        bool pop(uint8_t *state);
+
+        // Number of states held and bytes used by their deltas
+        size_t size();
+        size_t memoryUsage();
+    };
+}
+
+#endif
@@ -0,0 +1,160 @@
+#include "saveState.h"
+#include "gbException.h"
+#include <cstring>
+
+namespace gasyboy
+{
+    StateWriter::StateWriter(uint8_t *buffer, const size_t &capacity)
+        : _buffer(buffer),
+          _capacity(capacity),
+          _size(0)
+    {
+    }
+
+    uint8_t *StateWriter::reserve(const size_t &size)
+    {
+        const size_t offset = _size;
+        _size += size;
+
+        if (!_buffer)
+        {
+            return nullptr;
+        }
+
+        if (_size > _capacity)
+        {
+            throw exception::GbException("Save state buffer too small");
+        }
+
+        return _buffer + offset;
+    }
+
+    void StateWriter::write8(const uint8_t &value)
+    {
+        if (uint8_t *out = reserve(1))
+        {
+            out[0] = value;
+        }
+    }
+
+    void StateWriter::write16(const uint16_t &value)
+    {
+        if (uint8_t *out = reserve(2))
+        {
+            out[0] = static_cast<uint8_t>(value);
+            out[1] = static_cast<uint8_t>(value >> 8);
+        }
+    }
+
+    void StateWriter::write32(const uint32_t &value)
+    {
+        if (uint8_t *out = reserve(4))
+        {
+            for (int i = 0; i < 4; i++)
+            {
+                out[i] = static_cast<uint8_t>(value >> (8 * i));
+            }
+        }
+    }
+
+    void StateWriter::write64(const uint64_t &value)
+    {
+        if (uint8_t *out = reserve(8))
+        {
+            for (int i = 0; i < 8; i++)
+            {
+                out[i] = static_cast<uint8_t>(value >> (8 * i));
+            }
+        }
+    }
+
+    void StateWriter::writeBool(const bool &value)
+    {
+        write8(value ? 1 : 0);
+    }
+
+    void StateWriter::writeBytes(const void *data, const size_t &size)
+    {
+        if (uint8_t *out = reserve(size))
+        {
+            std::memcpy(out, data, size);
+        }
+    }
+
+    size_t StateWriter::size()
+    {
+        return _size;
+    }
+
+    bool StateWriter::isCounting()
+    {
+        return _buffer == nullptr;
+    }
+
+    StateReader::StateReader(const uint8_t *buffer, const size_t &size)
+        : _buffer(buffer),
+          _size(size),
+          _offset(0)
+    {
+    }
+
+    const uint8_t *StateReader::consume(const size_t &size)
+    {
+        if (size > _size - _offset)
+        {
+            throw exception::GbException("Save state truncated");
+        }
+
+        const uint8_t *in = _buffer + _offset;
+        _offset += size;
+        return in;
+    }
+
+    uint8_t StateReader::read8()
+    {
+        return consume(1)[0];
+    }
+
+    uint16_t StateReader::read16()
+    {
+        const uint8_t *in = consume(2);
+        return static_cast<uint16_t>(in[0] | (in[1] << 8));
+    }
+
+    uint32_t StateReader::read32()
+    {
+        const uint8_t *in = consume(4);
+        uint32_t value = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            value |= static_cast<uint32_t>(in[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    uint64_t StateReader::read64()
+    {
+        const uint8_t *in = consume(8);
+        uint64_t value = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            value |= static_cast<uint64_t>(in[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    bool StateReader::readBool()
+    {
+        return read8() != 0;
+    }
+
+    void StateReader::readBytes(void *data, const size_t &size)
+    {
+        std::memcpy(data, consume(size), size);
+    }
+
+    size_t StateReader::offset()
+    {
+        return _offset;
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef _SAVE_STATE_H_
+#define _SAVE_STATE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gasyboy
+{
+    // Save state layout: "GBSS", version, then every component in a fixed order.
+    // Integers are little endian whatever the host is. Bump the version on any layout change.
+    static constexpr uint32_t SAVE_STATE_MAGIC = 0x53534247;
+    static constexpr uint16_t SAVE_STATE_VERSION = 5;
+
+    // Serializes into a caller-provided buffer, never allocates.
+    // Without a buffer it only counts, which gives the size a state needs.
+    class StateWriter
+    {
+        uint8_t *_buffer;
+        size_t _capacity;
+        size_t _size;
+
+        uint8_t *reserve(const size_t &size);
+
+    public:
+        StateWriter(uint8_t *buffer, const size_t &capacity);
+
+        void write8(const uint8_t &value);
+        void write16(const uint16_t &value);
+        void write32(const uint32_t &value);
+        void write64(const uint64_t &value);
+        void writeBool(const bool &value);
+        void writeBytes(const void *data, const size_t &size);
+
+        // Bytes written (or counted) so far
+        size_t size();
+
+        // True when there is no buffer and the writer only counts
+        bool isCounting();
+    };
+
+    // Reads a state written by StateWriter, throws when running past its end
+    class StateReader
+    {
+        const uint8_t *_buffer;
+        size_t _size;
+        size_t _offset;
+
+        const uint8_t *consume(const size_t &size);
+
+    public:
+        StateReader(const uint8_t *buffer, const size_t &size);
+
+        uint8_t read8();
+        uint16_t read16();
+        uint32_t read32();
+        uint64_t read64();
+        bool readBool();
+        void readBytes(void *data, const size_t &size);
+
+        // Bytes read so far
+        size_t offset();
+    };
+}
+
+#endif
@@ -0,0 +1,79 @@
+#include "sdlAudio.h"
+#include "logger.h"
+#include <algorithm>
+#include <cstring>
+
+namespace gasyboy
+{
+    SdlAudio::SdlAudio(const int &sampleRate)
+        : _device(0),
+          _sampleRate(sampleRate)
+    {
+        if (SDL_InitSubSystem(SDL_INIT_AUDIO) != 0)
+        {
+            utils::Logger::getInstance()->log(utils::Logger::LogType::INFO,
+                                              std::string("No audio: ") + SDL_GetError());
+            return;
+        }
+
+        SDL_AudioSpec wanted = {};
+        wanted.freq = sampleRate;
+        wanted.format = AUDIO_S16SYS;
+        wanted.channels = 2;
+        wanted.samples = 512;
+        wanted.callback = callback;
+        wanted.userdata = this;
+
+        SDL_AudioSpec obtained = {};
+        _device = SDL_OpenAudioDevice(nullptr, 0, &wanted, &obtained, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE);
+        if (_device == 0)
+        {
+            utils::Logger::getInstance()->log(utils::Logger::LogType::INFO,
+                                              std::string("No audio device: ") + SDL_GetError());
+            return;
+        }
+
+        _sampleRate = obtained.freq;
+        SDL_PauseAudioDevice(_device, 0);
+    }
+
+    SdlAudio::~SdlAudio()
+    {
+        if (_device != 0)
+        {
+            SDL_CloseAudioDevice(_device);
+        }
+    }
+
+    bool SdlAudio::isOpen()
+    {
+        return _device != 0;
+    }
+
+    int SdlAudio::getSampleRate()
+    {
+        return _sampleRate;
+    }
+
+    void SdlAudio::push(const int16_t *samples, const size_t &frames)
+    {
+        // Whole frames only, the channels would swap otherwise
+        const size_t free = (_ring.capacity() - _ring.size()) & ~static_cast<size_t>(1);
+        _ring.push(samples, std::min(frames * 2, free));
+    }
+
+    size_t SdlAudio::queuedFrames()
+    {
+        return _ring.size() / 2;
+    }
+
+    void SdlAudio::callback(void *userdata, Uint8 *stream, int length)
+    {
+        auto *audio = static_cast<SdlAudio *>(userdata);
+        auto *out = reinterpret_cast<int16_t *>(stream);
+        const size_t count = static_cast<size_t>(length) / sizeof(int16_t);
+
+        const size_t popped = audio->_ring.pop(out, count);
+        std::memset(out + popped, 0, (count - popped) * sizeof(int16_t));
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef _SDL_AUDIO_H_
+#define _SDL_AUDIO_H_
+
+#ifdef EMSCRIPTEN
+#include <SDL2/SDL.h>
+#else
+#include "SDL.h"
+#endif
+
+#include "spscQueue.h"
+#include <cstdint>
+
+namespace gasyboy
+{
+    // SDL audio device playing the APU output. The core pushes stereo frames into a lock-free ring
+    // the device callback drains, neither side ever waits for the other.
+    class SdlAudio
+    {
+    public:
+        // 16 bit samples, two per frame, about 85 ms at 48 kHz
+        static constexpr size_t RING_SAMPLES = 8192;
+
+        SdlAudio(const int &sampleRate);
+        ~SdlAudio();
+
+        SdlAudio(const SdlAudio &) = delete;
+        SdlAudio &operator=(const SdlAudio &) = delete;
+
+        // False when no device could be opened, everything is then dropped
+        bool isOpen();
+
+        // Rate the device was opened at, which may differ from the one asked for
+        int getSampleRate();
+
+        // Emulation side, frames that do not fit are dropped
+        void push(const int16_t *samples, const size_t &frames);
+
+        // Stereo frames waiting in the ring, and how many it holds at most
+        size_t queuedFrames();
+        static constexpr size_t capacityFrames()
+        {
+            return SpscQueue<int16_t, RING_SAMPLES>::capacity() / 2;
+        }
+
+    private:
+        SDL_AudioDeviceID _device;
+        int _sampleRate;
+        SpscQueue<int16_t, RING_SAMPLES> _ring;
+
+        // Device side, pads with silence when the ring runs dry
+        static void callback(void *userdata, Uint8 *stream, int length);
+    };
+}
+
+#endif
@@ -0,0 +1,152 @@
+#include "sdlInputHandler.h"
+#include "gameboy.h"
+#include "defs.h"
+#include "profiler.h"
+#ifdef EMSCRIPTEN
+#include <SDL2/SDL.h>
+#else
+#include "SDL.h"
+#include "imgui_impl_sdl2.h"
+#endif
+
+namespace gasyboy
+{
+    void SdlInputHandler::init(GameBoy &gameboy)
+    {
+        // Created before the core, attach to it now that it exists
+        _gameboy = &gameboy;
+    }
+
+    void SdlInputHandler::waitEvent(const int &timeoutMs)
+    {
+#ifndef EMSCRIPTEN
+        // The event stays queued for handleEvent, the browser main loop must not block
+        SDL_WaitEventTimeout(nullptr, timeoutMs);
+#endif
+    }
+
+    void SdlInputHandler::handleEvent()
+    {
+        GASYBOY_PROFILE_SCOPE("SdlInputHandler::handleEvent");
+
+        auto &gamepad = _gameboy->getGamepad();
+        auto &utilities = _gameboy->getUtilities();
+        SDL_Event event;
+
+        while (SDL_PollEvent(&event) != 0)
+        {
+#ifndef EMSCRIPTEN
+            if (utilities.debugMode)
+            {
+                ImGui_ImplSDL2_ProcessEvent(&event);
+            }
+#endif
+
+            if (event.type == SDL_QUIT)
+            {
+                quit(ExitState::MANUAL_STOP);
+            }
+            else if (event.type == SDL_DROPFILE)
+            {
+                // Resetting gambeoy instance and loading new ROM
+                char *droppedFile = event.drop.file;
+                if (droppedFile)
+                {
+                    std::string filePath(droppedFile);
+                    utilities.newRomFilePath = filePath;
+                    utilities.wasReset = true;
+                    SDL_free(droppedFile);
+                }
+            }
+
+            else if (event.type == SDL_KEYDOWN)
+            {
+                gamepad.queueInput(joypadButton(event.key.keysym.sym), true);
+
+                switch (event.key.keysym.sym)
+                {
+                case SDLK_ESCAPE:
+                    quit(ExitState::MANUAL_STOP);
+                    break;
+
+                case SDLK_DOLLAR:
+                    utilities.wasRefreshed = true;
+                    break;
+
+                case SDLK_KP_MULTIPLY:
+                case SDLK_ASTERISK:
+                    utilities.wasReset = true;
+                    break;
+
+                case SDLK_TAB:
+                    _gameboy->cycleSpeed();
+                    break;
+
+                case SDLK_BACKSPACE:
+                    _gameboy->setRewinding(true);
+                    break;
+
+                case SDLK_p:
+                    gamepad.setChangePalette(true);
+                }
+            }
+
+            if (event.type == SDL_KEYUP)
+            {
+                if (event.key.keysym.sym == SDLK_ESCAPE)
+                {
+                    quit(0);
+                }
+
+                if (event.key.keysym.sym == SDLK_BACKSPACE)
+                {
+                    _gameboy->setRewinding(false);
+                }
+
+                const int button = joypadButton(event.key.keysym.sym);
+                if (button != Gamepad::NO_BUTTON)
+                {
+                    gamepad.queueInput(button, false);
+                }
+            }
+        }
+
+        if (utilities.wasReset)
+        {
+            _gameboy->reset();
+            utilities.wasReset = false;
+        }
+    }
+
+    int SdlInputHandler::joypadButton(const int &key)
+    {
+        switch (key)
+        {
+        case SDLK_UP:
+            return Gamepad::Button::UP;
+        case SDLK_RETURN:
+            return Gamepad::Button::SELECT;
+        case SDLK_DOWN:
+            return Gamepad::Button::DOWN;
+        case SDLK_SPACE:
+            return Gamepad::Button::START;
+        case SDLK_RIGHT:
+            return Gamepad::Button::RIGHT;
+        case SDLK_a:
+            return Gamepad::Button::A;
+        case SDLK_LEFT:
+            return Gamepad::Button::LEFT;
+        case SDLK_z:
+            return Gamepad::Button::B;
+        default:
+            return Gamepad::NO_BUTTON;
+        }
+    }
+
+    void SdlInputHandler::quit(const int &exitCode)
+    {
+        _gameboy->stopEmulationThread();
+        _gameboy->writeExecutionStats();
+        exit(exitCode);
+    }
+}
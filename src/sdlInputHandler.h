@@ -0,0 +1,30 @@
+#ifndef _SDL_INPUT_HANDLER_H_
+#define _SDL_INPUT_HANDLER_H_
+
+#include "frontend.h"
+
+namespace gasyboy
+{
+    // Polls SDL events: joypad keys go to the Gamepad queue, the rest are emulator hotkeys
+    class SdlInputHandler : public IInputHandler
+    {
+        // Instance this frontend is attached to
+        GameBoy *_gameboy = nullptr;
+
+        // Joypad button mapped to a key, Gamepad::NO_BUTTON if none
+        static int joypadButton(const int &key);
+
+        // Stop the emulation thread before leaving
+        void quit(const int &exitCode);
+
+    public:
+        SdlInputHandler() = default;
+        ~SdlInputHandler() = default;
+
+        void init(GameBoy &gameboy) override;
+        void handleEvent() override;
+        void waitEvent(const int &timeoutMs) override;
+    };
+}
+
+#endif
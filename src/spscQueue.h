@@ -0,0 +1,124 @@
+#ifndef _SPSC_QUEUE_H_
+#define _SPSC_QUEUE_H_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace gasyboy
+{
+    // Bounded lock-free queue for one producer thread and one consumer thread.
+    // Capacity must be a power of two, one slot is kept free to tell full from empty.
+    template <typename T, size_t Capacity>
+    class SpscQueue
+    {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+        std::array<T, Capacity> _items;
+
+        // Kept on separate cache lines so producer and consumer don't fight over them
+        alignas(64) std::atomic<size_t> _head;
+        alignas(64) std::atomic<size_t> _tail;
+
+    public:
+        SpscQueue()
+            : _items(),
+              _head(0),
+              _tail(0)
+        {
+        }
+
+        SpscQueue(const SpscQueue &) = delete;
+        SpscQueue &operator=(const SpscQueue &) = delete;
+
+        // Producer side, false when the queue is full
+        bool push(const T &item)
+        {
+            const size_t tail = _tail.load(std::memory_order_relaxed);
+            const size_t next = (tail + 1) & (Capacity - 1);
+
+            if (next == _head.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+
+            _items[tail] = item;
+            _tail.store(next, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side, false when the queue is empty
+        bool pop(T &item)
+        {
+            const size_t head = _head.load(std::memory_order_relaxed);
+
+            if (head == _tail.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+
+            item = _items[head];
+            _head.store((head + 1) & (Capacity - 1), std::memory_order_release);
+            return true;
+        }
+
+        // Producer side, copies as many items as fit and returns how many
+        size_t push(const T *items, const size_t &count)
+        {
+            const size_t tail = _tail.load(std::memory_order_relaxed);
+            const size_t free = (_head.load(std::memory_order_acquire) - tail - 1) & (Capacity - 1);
+            const size_t pushed = std::min(count, free);
+
+            for (size_t i = 0; i < pushed; i++)
+            {
+                _items[(tail + i) & (Capacity - 1)] = items[i];
+            }
+
+            _tail.store((tail + pushed) & (Capacity - 1), std::memory_order_release);
+            return pushed;
+        }
+
+        // Consumer side, copies up to count items and returns how many
+        size_t pop(T *items, const size_t &count)
+        {
+            const size_t head = _head.load(std::memory_order_relaxed);
+            const size_t used = (_tail.load(std::memory_order_acquire) - head) & (Capacity - 1);
+            const size_t popped = std::min(count, used);
+
+            for (size_t i = 0; i < popped; i++)
+            {
+                items[i] = _items[(head + i) & (Capacity - 1)];
+            }
+
+            _head.store((head + popped) & (Capacity - 1), std::memory_order_release);
+            return popped;
+        }
+
+        // Items queued, exact from either side, an estimate from any other thread
+        size_t size() const
+        {
+            return (_tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire)) & (Capacity - 1);
+        }
+
+        // Items that can be pushed at most
+        static constexpr size_t capacity()
+        {
+            return Capacity - 1;
+        }
+
+        bool empty() const
+        {
+            return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+        }
+
+        // Drop everything, only while neither side is active
+        void clear()
+        {
+            _head.store(0, std::memory_order_relaxed);
+            _tail.store(0, std::memory_order_relaxed);
+        }
+    };
+}
+
+#endif
@@ -1,148 +1,220 @@
-#include "interruptManagerProvider.h"
+#include "interruptManager.h"
 #include "timer.h"
+#include "profiler.h"
+#include <limits>
 
 namespace gasyboy
 {
-	uint8_t Timer::_div = 0;
-	uint8_t Timer::_tima = 0;
-	uint8_t Timer::_tma = 0;
-	uint8_t Timer::_tac = 0;
+	static constexpr uint64_t NEVER = std::numeric_limits<uint64_t>::max();
 
-	int Timer::_divIncrementRate = 255;
-	int Timer::_timaIncrementRate = 1024;
-
-	Timer::Timer()
+	Timer::Timer(InterruptManager &interruptManager)
+		: _interruptManager(interruptManager),
+		  _cycles(0),
+		  _counterBase(0),
+		  _tima(0),
+		  _timaSync(0),
+		  _tma(0),
+		  _tac(0),
+		  _overflowAt(NEVER)
 	{
-		_div = 0;
-		_tima = 0;
-		_tma = 0;
-		_tac = 0;
-		_divIncrementRate = 255;
-		_timaIncrementRate = 1024;
 	}
 
 	Timer &Timer::operator=(const Timer &other)
 	{
-		_div = other._div;
+		_cycles = other._cycles;
+		_counterBase = other._counterBase;
 		_tima = other._tima;
+		_timaSync = other._timaSync;
 		_tma = other._tma;
 		_tac = other._tac;
-		_divIncrementRate = other._divIncrementRate;
-		_timaIncrementRate = other._timaIncrementRate;
+		_overflowAt = other._overflowAt;
 		return *this;
 	}
 
 	void Timer::reset()
 	{
+		_cycles = 0;
+		_counterBase = 0;
+		_tima = 0;
+		_timaSync = 0;
+		_tma = 0;
+		_tac = 0;
+		_overflowAt = NEVER;
 	}
 
-	uint8_t Timer::DIV()
+	void Timer::saveState(StateWriter &writer)
 	{
-		return _div;
+		writer.write64(_cycles);
+		writer.write64(_counterBase);
+		writer.write8(_tima);
+		writer.write64(_timaSync);
+		writer.write8(_tma);
+		writer.write8(_tac);
+		writer.write64(_overflowAt);
 	}
 
-	uint8_t Timer::TIMA()
+	void Timer::loadState(StateReader &reader)
 	{
-		return _tima;
+		_cycles = reader.read64();
+		_counterBase = reader.read64();
+		_tima = reader.read8();
+		_timaSync = reader.read64();
+		_tma = reader.read8();
+		_tac = reader.read8();
+		_overflowAt = reader.read64();
 	}
 
-	uint8_t Timer::TMA()
+	bool Timer::enabled()
 	{
-		return _tma;
+		return (_tac >> 2) & 0x1;
 	}
 
-	uint8_t Timer::TAC()
+	uint64_t Timer::period()
 	{
-		return _tac;
+		// Bits 9, 3, 5 and 7 of the system counter
+		static constexpr uint64_t periods[4] = {1024, 16, 64, 256};
+		return periods[_tac & 0x3];
 	}
 
-	void Timer::setDIV(const uint8_t &value)
+	uint64_t Timer::counterAt(const uint64_t &cycles)
 	{
-		_div = value;
+		return cycles - _counterBase;
 	}
 
-	void Timer::setTIMA(const uint8_t &value)
+	void Timer::syncTIMA()
 	{
-		_tima = value;
+		// The overflow event fires before TIMA could wrap, the edges always fit
+		if (enabled())
+		{
+			_tima += static_cast<uint8_t>(counterAt(_cycles) / period() - counterAt(_timaSync) / period());
+		}
+		_timaSync = _cycles;
 	}
 
-	void Timer::setTMA(const uint8_t &value)
+	void Timer::incrementTIMA()
 	{
-		_tma = value;
+		if (++_tima == 0)
+		{
+			_tima = _tma;
+			_interruptManager.requestInterrupt(InterruptManager::InterruptType::Timer);
+		}
 	}
 
-	void Timer::setTAC(const uint8_t &value)
+	void Timer::scheduleOverflow()
+	{
+		if (!enabled())
+		{
+			_overflowAt = NEVER;
+			return;
+		}
+
+		// The edge taking TIMA from 0xFF to 0x100
+		const uint64_t edges = 0x100 - _tima;
+		_overflowAt = _counterBase + (counterAt(_cycles) / period() + edges) * period();
+	}
+
+	void Timer::overflow()
 	{
-		_tac = value;
+		// Edges are aligned on the period, the next overflow is a whole number of periods away
+		_tima = _tma;
+		_timaSync = _overflowAt;
+		_overflowAt += (0x100 - _tma) * period();
+		_interruptManager.requestInterrupt(InterruptManager::InterruptType::Timer);
 	}
 
-	void Timer::update(const uint16_t &cycles)
+	uint8_t Timer::DIV()
 	{
-		updateDIV(cycles);
-		updateTIMA(cycles);
+		return static_cast<uint8_t>(counterAt(_cycles) >> 8);
 	}
 
-	void Timer::updateDIV(const uint16_t &cycle)
+	uint8_t Timer::TIMA()
 	{
-		_divIncrementRate -= cycle;
-		if (_divIncrementRate <= 0)
-		{
-			_divIncrementRate = 255;
-			_div++;
-		}
+		syncTIMA();
+		return _tima;
+	}
+
+	uint8_t Timer::TMA()
+	{
+		return _tma;
+	}
+
+	uint8_t Timer::TAC()
+	{
+		// Unused bits read as 1
+		return 0xF8 | _tac;
+	}
+
+	void Timer::setDIV(const uint8_t &)
+	{
+		setSystemCounter(0);
 	}
 
 	void Timer::resetDIV()
 	{
-		_div = 0;
+		setSystemCounter(0);
+	}
+
+	uint16_t Timer::systemCounter()
+	{
+		return static_cast<uint16_t>(counterAt(_cycles));
 	}
 
-	void Timer::updateTIMA(const uint16_t &cycle)
+	void Timer::setSystemCounter(const uint16_t &value)
 	{
-		// If the TIMA control is enabled
-		if ((_tac >> 2) & 0x1)
+		syncTIMA();
+
+		// TIMA counts a falling edge if the selected bit was set
+		const uint64_t bit = period() / 2;
+		if (enabled() && (counterAt(_cycles) & bit) && !(value & bit))
 		{
-			_timaIncrementRate -= cycle;
-			if (_timaIncrementRate <= 0)
-			{
-				updateTAC(_tac);
-				_tima++;
-				if (_tima > 0xFF)
-				{
-					_tima = _tma;
-					provider::InterruptManagerProvider::getInstance()->requestInterrupt(InterruptManager::InterruptType::Timer);
-				}
-			}
+			incrementTIMA();
 		}
+
+		_counterBase = _cycles - value;
+		scheduleOverflow();
 	}
 
-	void Timer::updateTMA(const uint16_t &value)
+	void Timer::setTIMA(const uint8_t &value)
+	{
+		syncTIMA();
+		_tima = value;
+		scheduleOverflow();
+	}
+
+	void Timer::setTMA(const uint8_t &value)
 	{
-		_tma = static_cast<uint8_t>(value);
+		_tma = value;
 	}
 
-	void Timer::updateTAC(const uint8_t &value)
+	void Timer::setTAC(const uint8_t &value)
 	{
-		_tac = static_cast<uint8_t>(value);
-		switch (value & 0x3)
+		syncTIMA();
+
+		// The selected bit is ANDed with the enable bit, it falling counts as an edge
+		const bool wasHigh = enabled() && (counterAt(_cycles) & (period() / 2));
+		_tac = value & 0x7;
+		const bool isHigh = enabled() && (counterAt(_cycles) & (period() / 2));
+		if (wasHigh && !isHigh)
 		{
-		case 0:
-			_timaIncrementRate = 1024;
-			break;
-		case 1:
-			_timaIncrementRate = 16;
-			break;
-		case 2:
-			_timaIncrementRate = 64;
-			break;
-		case 3:
-			_timaIncrementRate = 255;
-			break;
+			incrementTIMA();
 		}
+
+		scheduleOverflow();
+	}
+
+	uint64_t Timer::cyclesToOverflow()
+	{
+		return _overflowAt - _cycles;
 	}
 
-	void Timer::stopTimer()
+	void Timer::update(const uint32_t &cycles)
 	{
-		_div = 0;
+		GASYBOY_PROFILE_SCOPE("Timer::update");
+
+		_cycles += cycles;
+		while (_cycles >= _overflowAt)
+		{
+			overflow();
+		}
 	}
-}
\ No newline at end of file
+}
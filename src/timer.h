@@ -2,49 +2,87 @@
 #define _TIMER_H_
 
 #include <cstdint>
+#include "saveState.h"
 
 namespace gasyboy
 {
     class InterruptManager;
 
+    // DIV is the upper byte of a 16 bit system counter running at the CPU clock, TIMA counts falling
+    // edges of one of its bits. Both are worked out from the cycle count when read, only the next TIMA
+    // overflow is an event, so an instruction costs one addition and one comparison.
     class Timer
     {
     public:
-        Timer();
+        Timer(InterruptManager &interruptManager);
         Timer &operator=(const Timer &);
         ~Timer() = default;
 
         void reset();
 
-        // Timer registers
-        static uint8_t _div;
-        static uint8_t _tima;
-        static uint8_t _tma;
-        static uint8_t _tac;
+        // Save state
+        void saveState(StateWriter &writer);
+        void loadState(StateReader &reader);
 
-        static int _divIncrementRate;
-        static int _timaIncrementRate;
+        uint8_t DIV();
+        uint8_t TIMA();
+        uint8_t TMA();
+        uint8_t TAC();
 
-        static uint8_t DIV();
-        static uint8_t TIMA();
-        static uint8_t TMA();
-        static uint8_t TAC();
+        // Any write to DIV clears the system counter
+        void setDIV(const uint8_t &value);
+        void setTIMA(const uint8_t &value);
+        void setTMA(const uint8_t &value);
+        void setTAC(const uint8_t &value);
 
-        static void setDIV(const uint8_t &value);
-        static void setTIMA(const uint8_t &value);
-        static void setTMA(const uint8_t &value);
-        static void setTAC(const uint8_t &value);
+        // The whole 16 bit counter, for the debugger
+        uint16_t systemCounter();
+        void setSystemCounter(const uint16_t &value);
 
-        void update(const uint16_t &cycles);
+        // Advance by the cycles of the last instruction, fires the overflow interrupt when it is due
+        void update(const uint32_t &cycles);
 
-        static void updateDIV(const uint16_t &cycle);
-        static void resetDIV();
-        static void updateTIMA(const uint16_t &cycle);
-        static void updateTMA(const uint16_t &value);
-        static void updateTAC(const uint8_t &value);
+        // Cycles left before the next overflow, huge when the timer is stopped
+        uint64_t cyclesToOverflow();
 
-        void stopTimer();
+        void resetDIV();
+
+    private:
+        // Where the timer overflow interrupt is requested
+        InterruptManager &_interruptManager;
+
+        // Cycles since reset, the clock everything else is relative to
+        uint64_t _cycles;
+
+        // Cycle count at which the system counter was last zero
+        uint64_t _counterBase;
+
+        // TIMA as of the cycle count _timaSync, falling edges since then are added on read
+        uint8_t _tima;
+        uint64_t _timaSync;
+
+        uint8_t _tma;
+        uint8_t _tac;
+
+        // Cycle count of the next TIMA overflow, never when the timer is stopped
+        uint64_t _overflowAt;
+
+        bool enabled();
+
+        // Cycles between TIMA increments for the selected clock
+        uint64_t period();
+
+        uint64_t counterAt(const uint64_t &cycles);
+
+        // Fold the edges counted so far into _tima
+        void syncTIMA();
+
+        // One TIMA increment outside the regular edges, when the selected bit falls on a write
+        void incrementTIMA();
+
+        void scheduleOverflow();
+        void overflow();
     };
 }
 
-#endif
\ No newline at end of file
+#endif
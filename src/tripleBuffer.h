@@ -0,0 +1,69 @@
+#ifndef _TRIPLE_BUFFER_H_
+#define _TRIPLE_BUFFER_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace gasyboy
+{
+    // Lock-free triple buffer between one writer and one reader.
+    // The writer fills the back slot and publishes it, the reader picks up the newest
+    // published slot. Neither side ever waits, frames the reader misses are dropped.
+    template <typename T>
+    class TripleBuffer
+    {
+        // Bits 0-1: index of the shared slot, bit 2: the shared slot holds an unread value
+        static constexpr uint8_t INDEX_MASK = 0x03;
+        static constexpr uint8_t FRESH = 0x04;
+
+        std::array<T, 3> _slots;
+        std::atomic<uint8_t> _shared;
+
+        // Only touched by the writer / the reader
+        uint8_t _back;
+        uint8_t _front;
+
+    public:
+        TripleBuffer()
+            : _slots(),
+              _shared(1),
+              _back(0),
+              _front(2)
+        {
+        }
+
+        TripleBuffer(const TripleBuffer &) = delete;
+        TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+        // Writer side: slot to fill, then hand it over
+        T &back()
+        {
+            return _slots[_back];
+        }
+
+        void publish()
+        {
+            _back = _shared.exchange(_back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+        }
+
+        // Reader side: take the newest published slot, false if nothing new since the last call
+        bool update()
+        {
+            if (!(_shared.load(std::memory_order_relaxed) & FRESH))
+            {
+                return false;
+            }
+
+            _front = _shared.exchange(_front, std::memory_order_acq_rel) & INDEX_MASK;
+            return true;
+        }
+
+        const T &front() const
+        {
+            return _slots[_front];
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef _UTILITIES_H_
+#define _UTILITIES_H_
+
+#include "blipBuffer.h"
+#include <string>
+
+namespace gasyboy
+{
+    // Settings of one emulator instance
+    struct Utilities
+    {
+        bool executeBios = true;
+        std::string romFilePath;
+        std::string newRomFilePath;
+        bool debugMode = false;
+        bool wasReset = false;
+        bool wasRefreshed = false;
+        bool threadedPpu = false;
+        bool vsync = false;
+        bool audioSync = false;
+        BlipBuffer::Quality audioQuality = BlipBuffer::Quality::MEDIUM;
+        bool frameStats = false;
+        bool threadedEmulation = true;
+        int speed = 1;
+
+        // Seconds of rewind history, 0 disables it, and frames between two snapshots
+        int rewindSeconds = 0;
+        int rewindInterval = 2;
+
+        // Frames emulated ahead of the real one and presented in its place, 0 disables it
+        int runAhead = 0;
+
+        // Count executions per opcode, bank and address and write the report there, empty disables it
+        std::string executionStatsPath;
+    };
+}
+
+#endif
@@ -2,11 +2,40 @@
 #include "logger.h"
 #include "utils.h"
 #include "defs.h"
+#include <cstring>
 
 namespace gasyboy
 {
     namespace utils
     {
+        uint64_t hash64(const void *data, const size_t &size, uint64_t seed)
+        {
+            constexpr uint64_t prime = 0x9E3779B97F4A7C15ULL;
+            const uint8_t *bytes = static_cast<const uint8_t *>(data);
+
+            uint64_t hash = seed ^ (size * prime);
+            size_t i = 0;
+
+            // Mix 8 bytes at a time, memcpy keeps unaligned loads well defined
+            for (; i + 8 <= size; i += 8)
+            {
+                uint64_t word;
+                std::memcpy(&word, bytes + i, 8);
+                hash = (hash ^ word) * prime;
+                hash ^= hash >> 29;
+            }
+
+            for (; i < size; i++)
+            {
+                hash = (hash ^ bytes[i]) * prime;
+            }
+
+            hash ^= hash >> 32;
+            hash *= prime;
+            hash ^= hash >> 29;
+            return hash;
+        }
+
         gasyboy::Cartridge::Cartridge::CartridgeType uint8ToCartridgeType(const uint8_t &value)
         {
             switch (value)
@@ -2,6 +2,8 @@
 #define _UTILS_H_
 
 #include "cartridge.h"
+#include <cstdint>
+#include <cstddef>
 #include <string>
 
 namespace gasyboy
@@ -11,6 +13,9 @@ namespace gasyboy
         // Convert Uint8 to CartridgeType
         Cartridge::CartridgeType uint8ToCartridgeType(const uint8_t &value);
 
+        // Fast non-cryptographic 64 bit hash, used to detect unchanged frames and memory
+        uint64_t hash64(const void *data, const size_t &size, uint64_t seed = 0);
+
         class XToString
         {
         public:
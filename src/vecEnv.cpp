@@ -0,0 +1,204 @@
+#include "vecEnv.h"
+#include "gameboy.h"
+#include "nullFrontend.h"
+#include "gbException.h"
+#include <algorithm>
+#include <random>
+
+namespace gasyboy
+{
+    VecEnv::VecEnv(const std::string &romPath, const size_t &count, const int &threads,
+                   const Observation &observation, const bool &executeBios)
+        : _observation(observation),
+          _job(),
+          _generation(0),
+          _runningWorkers(0),
+          _stop(false)
+    {
+        if (count == 0)
+        {
+            throw exception::GbException("VecEnv needs at least one instance");
+        }
+
+        auto utilities = std::make_shared<Utilities>();
+        utilities->romFilePath = romPath;
+        utilities->executeBios = executeBios;
+        utilities->threadedEmulation = false;
+        utilities->speed = GameBoy::SPEED_UNCAPPED;
+
+        auto first = std::make_unique<GameBoy>(utilities, std::make_unique<NullRenderer>(), std::make_unique<NullInputHandler>());
+        _initialState.resize(first->saveStateSize());
+        first->saveState(_initialState.data(), _initialState.size());
+
+        // Every other instance shares the first one's ROM
+        _instances.reserve(count);
+        _instances.push_back(std::move(first));
+        while (_instances.size() < count)
+        {
+            _instances.push_back(_instances.front()->fork());
+        }
+
+        // Serial output would otherwise pile up in the shared log
+        for (auto &instance : _instances)
+        {
+            instance->getMmu().setSerialHandler([](const uint8_t &) {});
+        }
+
+        const size_t workerCount = std::min(count, static_cast<size_t>(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())));
+        for (size_t worker = 0; worker < workerCount; worker++)
+        {
+            _workers.emplace_back(&VecEnv::run, this, worker * count / workerCount, (worker + 1) * count / workerCount);
+        }
+    }
+
+    VecEnv::~VecEnv()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _condition.notify_all();
+
+        for (auto &worker : _workers)
+        {
+            worker.join();
+        }
+    }
+
+    size_t VecEnv::size()
+    {
+        return _instances.size();
+    }
+
+    size_t VecEnv::observationSize()
+    {
+        return _observation == Observation::SHADES ? SCREEN_WIDTH * SCREEN_HEIGHT : (SCREEN_WIDTH / 2) * (SCREEN_HEIGHT / 2);
+    }
+
+    void VecEnv::reset(const uint64_t &seed, uint8_t *observations)
+    {
+        _job = {true, seed, nullptr, 0, observations};
+        dispatch();
+    }
+
+    void VecEnv::step(const uint8_t *actions, const int &frames, uint8_t *observations)
+    {
+        _job = {false, 0, actions, frames, observations};
+        dispatch();
+    }
+
+    void VecEnv::dispatch()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _error = nullptr;
+        _runningWorkers = _workers.size();
+        _generation++;
+        _condition.notify_all();
+
+        _condition.wait(lock, [this]()
+                        { return _runningWorkers == 0; });
+
+        if (_error)
+        {
+            std::rethrow_exception(_error);
+        }
+    }
+
+    void VecEnv::run(const size_t &first, const size_t &last)
+    {
+        uint64_t generation = 0;
+
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _condition.wait(lock, [&]()
+                                { return _stop || _generation != generation; });
+                if (_stop)
+                {
+                    return;
+                }
+                generation = _generation;
+            }
+
+            std::exception_ptr error;
+            try
+            {
+                for (size_t index = first; index < last; index++)
+                {
+                    runJob(index);
+                }
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (error && !_error)
+                {
+                    _error = error;
+                }
+                _runningWorkers--;
+            }
+            _condition.notify_all();
+        }
+    }
+
+    void VecEnv::runJob(const size_t &index)
+    {
+        auto &gameboy = *_instances[index];
+        auto &gamepad = gameboy.getGamepad();
+
+        if (_job.reset)
+        {
+            gameboy.loadState(_initialState.data(), _initialState.size());
+
+            // Seeded per instance, the same seed always gives the same starts
+            std::mt19937_64 random(_job.seed + index);
+            const int noopFrames = static_cast<int>(random() % (MAX_NOOP_FRAMES + 1));
+
+            gamepad.setButtons(0xFF);
+            for (int frame = 0; frame < noopFrames; frame++)
+            {
+                gameboy.runToFrameEnd();
+            }
+        }
+        else
+        {
+            // The joypad clears a bit for a pressed button
+            gamepad.setButtons(static_cast<uint8_t>(~_job.actions[index]));
+            for (int frame = 0; frame < _job.frames; frame++)
+            {
+                gameboy.runToFrameEnd();
+            }
+        }
+
+        observe(gameboy, _job.observations + index * observationSize());
+    }
+
+    void VecEnv::observe(GameBoy &gameboy, uint8_t *out)
+    {
+        // Shades come from the PPU, observations do not depend on the display colours
+        const uint8_t *shades = gameboy.getPpu()._shadebuffer;
+
+        if (_observation == Observation::SHADES)
+        {
+            std::copy(shades, shades + SCREEN_WIDTH * SCREEN_HEIGHT, out);
+            return;
+        }
+
+        for (int y = 0; y < SCREEN_HEIGHT / 2; y++)
+        {
+            const uint8_t *top = shades + (y * 2) * SCREEN_WIDTH;
+            const uint8_t *bottom = top + SCREEN_WIDTH;
+            for (int x = 0; x < SCREEN_WIDTH / 2; x++)
+            {
+                // Shade 0 is white (255), each step darkens by 85
+                const int sum = top[x * 2] + top[x * 2 + 1] + bottom[x * 2] + bottom[x * 2 + 1];
+                *out++ = static_cast<uint8_t>(255 - sum * 85 / 4);
+            }
+        }
+    }
+}
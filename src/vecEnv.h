@@ -0,0 +1,87 @@
+#ifndef _VEC_ENV_H_
+#define _VEC_ENV_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gasyboy
+{
+    class GameBoy;
+
+    // Many headless instances of one ROM stepped in lockstep, for reinforcement learning.
+    // Each worker thread owns a contiguous slice of the instances, observations of all of them
+    // are written into one caller-allocated buffer, instance after instance.
+    class VecEnv
+    {
+    public:
+        enum class Observation
+        {
+            // 160x144 shade indices, 0 (white) to 3 (black)
+            SHADES,
+
+            // 80x72 grey levels, each the average of a 2x2 block, 0 black to 255 white
+            GRAYSCALE_HALF
+        };
+
+        // Most no-op frames run after a reset, so instances do not all start in lockstep
+        static constexpr int MAX_NOOP_FRAMES = 30;
+
+        // 0 threads uses every core
+        VecEnv(const std::string &romPath, const size_t &count, const int &threads = 0,
+               const Observation &observation = Observation::SHADES, const bool &executeBios = false);
+        ~VecEnv();
+
+        VecEnv(const VecEnv &) = delete;
+        VecEnv &operator=(const VecEnv &) = delete;
+
+        size_t size();
+
+        // Bytes of one instance's observation, the buffers passed below hold size() of them
+        size_t observationSize();
+
+        // Back to power-on, then a seeded number of no-op frames per instance
+        void reset(const uint64_t &seed, uint8_t *observations);
+
+        // actions holds one joypad mask per instance, bit n set presses Gamepad::Button n.
+        // It is held for the given number of frames, each run until the PPU completes it so observations never tear.
+        void step(const uint8_t *actions, const int &frames, uint8_t *observations);
+
+    private:
+        std::vector<std::unique_ptr<GameBoy>> _instances;
+        Observation _observation;
+
+        // Power-on state every reset restores
+        std::vector<uint8_t> _initialState;
+
+        // Current job, workers run it on their slice when the generation changes
+        struct Job
+        {
+            bool reset;
+            uint64_t seed;
+            const uint8_t *actions;
+            int frames;
+            uint8_t *observations;
+        } _job;
+
+        std::vector<std::thread> _workers;
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        uint64_t _generation;
+        size_t _runningWorkers;
+        bool _stop;
+        std::exception_ptr _error;
+
+        void run(const size_t &first, const size_t &last);
+        void runJob(const size_t &index);
+        void dispatch();
+        void observe(GameBoy &gameboy, uint8_t *out);
+    };
+}
+
+#endif
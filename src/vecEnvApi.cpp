@@ -0,0 +1,91 @@
+#include "vecEnvApi.h"
+#include "apiError.h"
+#include "vecEnv.h"
+#include <exception>
+
+struct gasyboy_vec_env
+{
+    gasyboy::VecEnv env;
+};
+
+namespace
+{
+    int fail(const std::exception &e)
+    {
+        gasyboy::api::setLastError(e.what());
+        return -1;
+    }
+}
+
+gasyboy_vec_env *gasyboy_vec_env_create(const char *rom_path, size_t count, int threads, int observation)
+{
+    try
+    {
+        if (!rom_path || (observation != GASYBOY_OBSERVATION_SHADES && observation != GASYBOY_OBSERVATION_GRAYSCALE_HALF))
+        {
+            gasyboy::api::setLastError("invalid argument");
+            return nullptr;
+        }
+
+        gasyboy::api::setLastError("");
+        return new gasyboy_vec_env{gasyboy::VecEnv(rom_path, count, threads, static_cast<gasyboy::VecEnv::Observation>(observation))};
+    }
+    catch (const std::exception &e)
+    {
+        fail(e);
+        return nullptr;
+    }
+}
+
+void gasyboy_vec_env_destroy(gasyboy_vec_env *env)
+{
+    delete env;
+}
+
+size_t gasyboy_vec_env_size(gasyboy_vec_env *env)
+{
+    return env ? env->env.size() : 0;
+}
+
+size_t gasyboy_vec_env_observation_size(gasyboy_vec_env *env)
+{
+    return env ? env->env.observationSize() : 0;
+}
+
+int gasyboy_vec_env_reset(gasyboy_vec_env *env, uint64_t seed, uint8_t *observations)
+{
+    if (!env || !observations)
+    {
+        gasyboy::api::setLastError("invalid argument");
+        return -1;
+    }
+
+    try
+    {
+        env->env.reset(seed, observations);
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        return fail(e);
+    }
+}
+
+int gasyboy_vec_env_step(gasyboy_vec_env *env, const uint8_t *actions, int frames, uint8_t *observations)
+{
+    if (!env || !actions || !observations || frames < 0)
+    {
+        gasyboy::api::setLastError("invalid argument");
+        return -1;
+    }
+
+    try
+    {
+        env->env.step(actions, frames, observations);
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        return fail(e);
+    }
+}
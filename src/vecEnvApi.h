@@ -0,0 +1,43 @@
+#ifndef _VEC_ENV_API_H_
+#define _VEC_ENV_API_H_
+
+/* C interface to VecEnv, for Python (ctypes, cffi) and other foreign callers.
+   Functions returning int give 0 on success and -1 on failure, gasyboy_last_error() tells why. */
+
+#include "gasyboyApi.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    typedef struct gasyboy_vec_env gasyboy_vec_env;
+
+    enum
+    {
+        /* 160x144 shade indices, 0 (white) to 3 (black) */
+        GASYBOY_OBSERVATION_SHADES = 0,
+
+        /* 80x72 grey levels, 0 black to 255 white */
+        GASYBOY_OBSERVATION_GRAYSCALE_HALF = 1
+    };
+
+    /* 0 threads uses every core. Returns NULL on failure. */
+    GASYBOY_API gasyboy_vec_env *gasyboy_vec_env_create(const char *rom_path, size_t count, int threads, int observation);
+    GASYBOY_API void gasyboy_vec_env_destroy(gasyboy_vec_env *env);
+
+    GASYBOY_API size_t gasyboy_vec_env_size(gasyboy_vec_env *env);
+
+    /* Bytes of one instance's observation, observation buffers hold size() of them back to back */
+    GASYBOY_API size_t gasyboy_vec_env_observation_size(gasyboy_vec_env *env);
+
+    GASYBOY_API int gasyboy_vec_env_reset(gasyboy_vec_env *env, uint64_t seed, uint8_t *observations);
+
+    /* One joypad mask per instance: bit 0 A, 1 B, 2 Select, 3 Start, 4 Right, 5 Left, 6 Up, 7 Down */
+    GASYBOY_API int gasyboy_vec_env_step(gasyboy_vec_env *env, const uint8_t *actions, int frames, uint8_t *observations);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
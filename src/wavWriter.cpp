@@ -0,0 +1,81 @@
+#include "wavWriter.h"
+#include "saveState.h"
+#include "gbException.h"
+#include <algorithm>
+
+namespace gasyboy
+{
+    namespace
+    {
+        constexpr size_t HEADER_SIZE = 44;
+    }
+
+    WavWriter::WavWriter(const std::string &path, const int &sampleRate, const int &channels)
+        : _file(path, std::ios::binary | std::ios::trunc),
+          _sampleRate(sampleRate),
+          _channels(channels),
+          _frames(0)
+    {
+        if (!_file.is_open())
+        {
+            throw exception::GbException("Unable to write WAV file: " + path);
+        }
+
+        writeHeader();
+    }
+
+    WavWriter::~WavWriter()
+    {
+        _file.seekp(0);
+        writeHeader();
+    }
+
+    void WavWriter::writeHeader()
+    {
+        // Sizes past 4 GiB are clamped, players read such files up to their end anyway
+        const uint32_t dataSize = static_cast<uint32_t>(std::min<uint64_t>(_frames * _channels * 2, UINT32_MAX - HEADER_SIZE));
+
+        uint8_t header[HEADER_SIZE];
+        StateWriter writer(header, sizeof(header));
+        writer.writeBytes("RIFF", 4);
+        writer.write32(static_cast<uint32_t>(HEADER_SIZE - 8 + dataSize));
+        writer.writeBytes("WAVEfmt ", 8);
+        writer.write32(16);
+        writer.write16(1);
+        writer.write16(static_cast<uint16_t>(_channels));
+        writer.write32(static_cast<uint32_t>(_sampleRate));
+        writer.write32(static_cast<uint32_t>(_sampleRate * _channels * 2));
+        writer.write16(static_cast<uint16_t>(_channels * 2));
+        writer.write16(16);
+        writer.writeBytes("data", 4);
+        writer.write32(dataSize);
+
+        _file.write(reinterpret_cast<const char *>(header), sizeof(header));
+        _file.flush();
+    }
+
+    void WavWriter::write(const int16_t *samples, const size_t &frames)
+    {
+        // WAV is little endian like StateWriter, samples go through it on any host
+        uint8_t bytes[4096];
+        const size_t count = frames * _channels;
+        for (size_t done = 0; done < count;)
+        {
+            const size_t chunk = std::min(count - done, sizeof(bytes) / 2);
+            StateWriter writer(bytes, sizeof(bytes));
+            for (size_t i = 0; i < chunk; i++)
+            {
+                writer.write16(static_cast<uint16_t>(samples[done + i]));
+            }
+            _file.write(reinterpret_cast<const char *>(bytes), chunk * 2);
+            done += chunk;
+        }
+
+        _frames += frames;
+    }
+
+    uint64_t WavWriter::getFrames()
+    {
+        return _frames;
+    }
+}
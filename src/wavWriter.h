@@ -0,0 +1,35 @@
+#ifndef _WAV_WRITER_H_
+#define _WAV_WRITER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace gasyboy
+{
+    // 16 bit PCM WAV file written as samples come, the sizes in the header are filled in when it is closed
+    class WavWriter
+    {
+        std::ofstream _file;
+        int _sampleRate;
+        int _channels;
+        uint64_t _frames;
+
+        void writeHeader();
+
+    public:
+        WavWriter(const std::string &path, const int &sampleRate, const int &channels);
+        ~WavWriter();
+
+        WavWriter(const WavWriter &) = delete;
+        WavWriter &operator=(const WavWriter &) = delete;
+
+        // Interleaved frames of _channels samples
+        void write(const int16_t *samples, const size_t &frames);
+
+        uint64_t getFrames();
+    };
+}
+
+#endif
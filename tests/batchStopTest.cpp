@@ -0,0 +1,57 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "batchRunner.h"
+
+// A ROM that executes STOP and never prints anything. Nothing can press a key in a batch run,
+// so the run has to end on the cycle budget instead of hanging with the clock frozen.
+namespace
+{
+    constexpr uint64_t CYCLE_BUDGET = 10000000;
+
+    std::vector<uint8_t> stopRom()
+    {
+        std::vector<uint8_t> rom(0x8000, 0);
+
+        // Entry point: NOP, JP 0x0150
+        const uint8_t entry[] = {0x00, 0xC3, 0x50, 0x01};
+        std::copy(std::begin(entry), std::end(entry), rom.begin() + 0x100);
+
+        // STOP, NOP, JR back to the STOP
+        const uint8_t code[] = {0x10, 0x00, 0x18, 0xFC};
+        std::copy(std::begin(code), std::end(code), rom.begin() + 0x150);
+
+        return rom;
+    }
+}
+
+int main()
+{
+    const auto romPath = std::filesystem::temp_directory_path() / "gasyboy_batch_stop.gb";
+    {
+        const auto rom = stopRom();
+        std::ofstream file(romPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(rom.data()), rom.size());
+    }
+
+    gasyboy::BatchEntry entry;
+    entry.romPath = romPath.string();
+    entry.cycleBudget = CYCLE_BUDGET;
+
+    const auto results = gasyboy::BatchRunner({entry}, 1).run();
+    std::filesystem::remove(romPath);
+
+    const auto &result = results.front();
+    std::cout << gasyboy::BatchResult::statusStr(result.status) << " (" << result.message << "), "
+              << result.cycles << " cycles\n";
+
+    if (result.status != gasyboy::BatchResult::Status::TIMEOUT || result.cycles < CYCLE_BUDGET)
+    {
+        std::cout << "expected a timeout after " << CYCLE_BUDGET << " cycles\n";
+        return 1;
+    }
+
+    return 0;
+}